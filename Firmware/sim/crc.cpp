@@ -0,0 +1,28 @@
+#include <CRC.h>
+
+uint16_t crc16(const uint8_t *array, uint16_t length, const uint16_t polynome,
+    const uint16_t startmask, const uint16_t endmask, const bool reverseIn, const bool reverseOut) {
+    uint16_t crc = startmask;
+    while (length--) {
+        uint8_t data = *array++;
+        if (reverseIn) {
+            uint8_t reversed = 0;
+            for (uint8_t i = 0; i < 8; ++i) {
+                reversed |= ((data >> i) & 1) << (7 - i);
+            }
+            data = reversed;
+        }
+        crc ^= (uint16_t)data << 8;
+        for (uint8_t i = 0; i < 8; ++i) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ polynome) : (uint16_t)(crc << 1);
+        }
+    }
+    if (reverseOut) {
+        uint16_t reversed = 0;
+        for (uint8_t i = 0; i < 16; ++i) {
+            reversed |= ((crc >> i) & 1) << (15 - i);
+        }
+        crc = reversed;
+    }
+    return crc ^ endmask;
+}
@@ -0,0 +1,494 @@
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include <M5StickCPlus.h>
+#include <WiFi.h>
+#include <esp_now.h>
+#include <Preferences.h>
+#include "hal.h"
+
+M5StickCPlus M5;
+EspClass ESP;
+WiFiClass WiFi;
+
+// Atomic, radio frames may come in from another thread. 64 bits like the
+// ESP32's timer: micros() wraps after 71 minutes, millis() does not.
+std::atomic<uint64_t> simTime(0);      // us
+
+uint32_t millis() {
+    return simTime / 1000;
+}
+
+uint32_t micros() {
+    return (uint32_t)simTime;
+}
+
+void delay(uint32_t ms) {
+    simTime += ms * 1000ULL;
+}
+
+void simAdvance(uint32_t ms) {
+    simTime += ms * 1000ULL;
+}
+
+void simSetMicros(uint64_t us) {
+    simTime = us;
+}
+
+#define SIM_PIN_COUNT 40
+
+int simPinLevels[SIM_PIN_COUNT];
+void (*simPinInterrupts[SIM_PIN_COUNT])() = {};
+
+void pinMode(uint8_t pin, uint8_t) {
+    // Inputs idle high, like the buttons with their pull-ups
+    simPinLevels[pin] = HIGH;
+}
+
+int digitalRead(uint8_t pin) {
+    return simPinLevels[pin];
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+    simPinLevels[pin] = level;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int) {
+    simPinInterrupts[pin] = isr;
+}
+
+void simSetPin(uint8_t pin, int level) {
+    if (simPinLevels[pin] != level) {
+        simPinLevels[pin] = level;
+        if (simPinInterrupts[pin] != NULL) {
+            simPinInterrupts[pin]();
+        }
+    }
+}
+
+// Follows the simulated clock so the profiler pages come out the same on every run
+uint32_t EspClass::getCycleCount() {
+    return micros() * getCpuFreqMHz();
+}
+
+struct SimQueue {
+    uint32_t itemSize;
+    uint32_t length;
+    std::deque<std::vector<uint8_t>> items;
+};
+
+std::vector<SimQueue *> simQueues;
+
+QueueHandle_t xQueueCreate(uint32_t length, uint32_t itemSize) {
+    SimQueue *queue = new SimQueue { itemSize, length, {} };
+    simQueues.push_back(queue);
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t) {
+    if (queue->items.size() >= queue->length) {
+        return pdFALSE;
+    }
+    // Semaphores queue empty items without a pointer
+    queue->items.emplace_back(queue->itemSize);
+    if (item != NULL) {
+        memcpy(queue->items.back().data(), item, queue->itemSize);
+    }
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait) {
+    if (queue->items.empty()) {
+        if (wait == portMAX_DELAY) {
+            fprintf(stderr, "sim: blocking receive on an empty queue would never return\n");
+            abort();
+        }
+        return pdFALSE;
+    }
+    if (item != NULL) {
+        memcpy(item, queue->items.front().data(), queue->itemSize);
+    }
+    queue->items.pop_front();
+    return pdTRUE;
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t) {
+    if (queue->items.empty()) {
+        return pdFALSE;
+    }
+    memcpy(item, queue->items.front().data(), queue->itemSize);
+    return pdTRUE;
+}
+
+// Only used on queues of length 1
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item) {
+    queue->items.clear();
+    return xQueueSend(queue, item, 0);
+}
+
+// A binary semaphore is a queue of at most one empty item
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return xQueueCreate(1, 0);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t wait) {
+    return xQueueReceive(semaphore, NULL, wait);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return xQueueSend(semaphore, NULL, 0);
+}
+
+uint32_t simQueuedItemCount(uint32_t itemSize) {
+    uint32_t count = 0;
+    for (const SimQueue *queue : simQueues) {
+        if (queue->itemSize > 0 && (itemSize == 0 || queue->itemSize == itemSize)) {
+            count += queue->items.size();
+        }
+    }
+    return count;
+}
+
+TFT_eSPI::TFT_eSPI() : frame(), swapBytes(false), pixelsPushed(0) {
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+    for (uint16_t& pixel : frame) {
+        pixel = color;
+    }
+    pixelsPushed += SIM_LCD_WIDTH * SIM_LCD_HEIGHT;
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data) {
+    for (int32_t row = 0; row < h; ++row) {
+        for (int32_t col = 0; col < w; ++col) {
+            uint16_t pixel = data[row * w + col];
+            int32_t px = x + col;
+            int32_t py = y + row;
+            if (px < 0 || py < 0 || px >= SIM_LCD_WIDTH || py >= SIM_LCD_HEIGHT) {
+                continue;
+            }
+            // Without byte swapping the data is already in the LCD's byte order
+            frame[py * SIM_LCD_WIDTH + px] = swapBytes ? pixel : (uint16_t)((pixel >> 8) | (pixel << 8));
+        }
+    }
+    pixelsPushed += w * h;
+}
+
+uint8_t simSpriteLimit = 0xff;
+uint8_t simSpritesCreated = 0;
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI *tft)
+    : tft(tft), bpp(16), width(0), height(0), buffer(NULL), textSize(1), textColor(WHITE), textDatum(TL_DATUM) {
+}
+
+TFT_eSprite::~TFT_eSprite() {
+    free(buffer);
+}
+
+void *TFT_eSprite::createSprite(int16_t w, int16_t h) {
+    if (simSpritesCreated >= simSpriteLimit) {
+        return NULL;
+    }
+    simSpritesCreated++;
+    width = w;
+    height = h;
+    size_t size = bpp == 4 ? ((w + 1) & ~1) / 2 * h : w * h * 2;
+    buffer = (uint8_t *)calloc(size, 1);
+    return buffer;
+}
+
+void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color) {
+    if (x < 0 || y < 0 || x >= width || y >= height) {
+        return;
+    }
+    if (bpp == 4) {
+        uint8_t *pair = &buffer[(y * ((width + 1) & ~1) + x) / 2];
+        if (x & 1) {
+            *pair = (*pair & 0xF0) | (color & 0x0F);
+        } else {
+            *pair = (*pair & 0x0F) | ((color & 0x0F) << 4);
+        }
+    } else {
+        ((uint16_t *)buffer)[y * width + x] = (uint16_t)((color >> 8) | (color << 8));
+    }
+}
+
+void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    for (int32_t row = y; row < y + h; ++row) {
+        for (int32_t col = x; col < x + w; ++col) {
+            drawPixel(col, row, color);
+        }
+    }
+}
+
+void TFT_eSprite::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+    int32_t dx = abs(x1 - x0);
+    int32_t dy = -abs(y1 - y0);
+    int32_t sx = x0 < x1 ? 1 : -1;
+    int32_t sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx + dy;
+    for (;;) {
+        drawPixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int32_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void TFT_eSprite::drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color) {
+    int16_t rowBytes = (w + 7) / 8;
+    for (int16_t row = 0; row < h; ++row) {
+        for (int16_t col = 0; col < w; ++col) {
+            if (bitmap[row * rowBytes + col / 8] & (1 << (col % 8))) {
+                drawPixel(x + col, y + row, color);
+            }
+        }
+    }
+}
+
+// Classic 5x7 glyphs for 0x20-0x7E, one byte per column, bit 0 at the top
+const uint8_t SimFont[95][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+    {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+    {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+    {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+    {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+    {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+    {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+    {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+    {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+    {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+    {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+    {0x3E, 0x41, 0x49, 0x49, 0x7A}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+    {0x7F, 0x02, 0x0C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+    {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+    {0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+    {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+    {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+    {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+    {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+    {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+    {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+    {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+};
+
+int16_t TFT_eSprite::drawString(const char *str, int32_t x, int32_t y) {
+    int32_t w = strlen(str) * 6 * textSize;
+    int32_t h = 8 * textSize;
+    if (textDatum == MC_DATUM) {
+        x -= w / 2;
+        y -= h / 2;
+    } else if (textDatum == TR_DATUM) {
+        x -= w;
+    }
+
+    for (const char *c = str; *c != '\0'; ++c, x += 6 * textSize) {
+        if (*c < 0x20 || *c > 0x7E) {
+            continue;
+        }
+        const uint8_t *glyph = SimFont[*c - 0x20];
+        for (int32_t col = 0; col < 5; ++col) {
+            for (int32_t row = 0; row < 8; ++row) {
+                if (glyph[col] & (1 << row)) {
+                    fillRect(x + col * textSize, y + row * textSize, textSize, textSize, textColor);
+                }
+            }
+        }
+    }
+    return w;
+}
+
+HardwareSerial Serial;
+CFastLED FastLED;
+
+std::string simSerialIn;
+std::string simSerialOut;
+
+int HardwareSerial::available() {
+    return simSerialIn.size();
+}
+
+int HardwareSerial::read() {
+    if (simSerialIn.empty()) {
+        return -1;
+    }
+    uint8_t c = simSerialIn[0];
+    simSerialIn.erase(0, 1);
+    return c;
+}
+
+int HardwareSerial::availableForWrite() {
+    // Like the UART TX FIFO
+    return 128;
+}
+
+size_t HardwareSerial::write(const uint8_t *data, size_t len) {
+    simSerialOut.append((const char *)data, len);
+    return len;
+}
+
+void simSerialInput(const std::string& bytes) {
+    simSerialIn += bytes;
+}
+
+std::string simSerialTakeOutput() {
+    std::string out;
+    out.swap(simSerialOut);
+    return out;
+}
+
+std::vector<SimRadioFrame> simRadioSent;
+esp_now_recv_cb_t simRadioCallback = NULL;
+
+esp_err_t esp_now_init() {
+    return ESP_OK;
+}
+
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t *) {
+    return ESP_OK;
+}
+
+esp_err_t esp_now_send(const uint8_t *, const uint8_t *data, size_t len) {
+    simRadioSent.push_back({ micros(), std::vector<uint8_t>(data, data + len) });
+    return ESP_OK;
+}
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback) {
+    simRadioCallback = callback;
+    return ESP_OK;
+}
+
+std::vector<SimRadioFrame>& simGetRadioSent() {
+    return simRadioSent;
+}
+
+void simRadioDeliver(const uint8_t *address, const uint8_t *data, int len) {
+    if (simRadioCallback != NULL) {
+        simRadioCallback(address, data, len);
+    }
+}
+
+// One flat map for all namespaces, keys are prefixed with the namespace
+std::map<std::string, std::vector<uint8_t>> simNvs;
+uint32_t simNvsWrites = 0;
+
+bool Preferences::begin(const char *name, bool) {
+    this->name = name;
+    return true;
+}
+
+bool Preferences::isKey(const char *key) {
+    return simNvs.count(name + "/" + key) > 0;
+}
+
+bool Preferences::remove(const char *key) {
+    simNvsWrites++;
+    return simNvs.erase(name + "/" + key) > 0;
+}
+
+uint8_t Preferences::getUChar(const char *key, uint8_t defaultValue) {
+    auto it = simNvs.find(name + "/" + key);
+    return it != simNvs.end() && it->second.size() == 1 ? it->second[0] : defaultValue;
+}
+
+bool Preferences::getBool(const char *key, bool defaultValue) {
+    return getUChar(key, defaultValue) != 0;
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+    auto it = simNvs.find(name + "/" + key);
+    return it != simNvs.end() ? it->second.size() : 0;
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+    auto it = simNvs.find(name + "/" + key);
+    if (it == simNvs.end() || it->second.size() > maxLen) {
+        return 0;
+    }
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+}
+
+size_t Preferences::putUChar(const char *key, uint8_t value) {
+    return putBytes(key, &value, 1);
+}
+
+size_t Preferences::putBool(const char *key, bool value) {
+    return putUChar(key, value ? 1 : 0);
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) {
+    const uint8_t *bytes = (const uint8_t *)value;
+    simNvs[name + "/" + key] = std::vector<uint8_t>(bytes, bytes + len);
+    simNvsWrites++;
+    return len;
+}
+
+uint32_t simGetNvsWrites() {
+    return simNvsWrites;
+}
+
+std::vector<CRGB> simShownPixels;
+uint32_t simLedShows = 0;
+
+void CFastLED::show() {
+    simShownPixels.clear();
+    for (int i = 0; i < controller.count; ++i) {
+        const CRGB& pixel = controller.leds[i];
+        simShownPixels.push_back(CRGB(pixel.r * (brightness + 1) >> 8, pixel.g * (brightness + 1) >> 8,
+            pixel.b * (brightness + 1) >> 8));
+    }
+    simLedShows++;
+}
+
+const std::vector<CRGB>& simGetShownPixels() {
+    return simShownPixels;
+}
+
+uint32_t simGetLedShows() {
+    return simLedShows;
+}
+
+uint32_t simBeeps = 0;
+bool simPoweredOff = false;
+
+void Beeper::beep() {
+    simBeeps++;
+}
+
+void AXP192::PowerOff() {
+    simPoweredOff = true;
+}
+
+uint32_t simGetBeeps() {
+    return simBeeps;
+}
+
+void simSetSpriteLimit(uint8_t count) {
+    simSpriteLimit = count;
+}
+
+bool simIsPoweredOff() {
+    return simPoweredOff;
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <M5StickCPlus.h>
+#include <FastLED.h>
+#include "system.h"
+
+// Moves the simulated clock behind millis() and micros() forward
+void simAdvance(uint32_t ms);
+
+// Sets the simulated clock, for simulators with their own time base
+void simSetMicros(uint64_t us);
+
+// Sets the level of an input pin and runs its interrupt on a change
+void simSetPin(uint8_t pin, int level);
+
+// A frame esp_now_send() put on air, still XOR encoded
+typedef struct {
+    uint32_t time;              // us
+    std::vector<uint8_t> data;
+} SimRadioFrame;
+
+// Every frame sent since the start, the simulator may clear it
+std::vector<SimRadioFrame>& simGetRadioSent();
+
+// Runs the ESP-NOW receive callback as the Wi-Fi task would
+void simRadioDeliver(const uint8_t *address, const uint8_t *data, int len);
+
+// Bytes the firmware reads from Serial next
+void simSerialInput(const std::string& bytes);
+
+// Everything written to Serial since the last call
+std::string simSerialTakeOutput();
+
+// Preferences writes since the start, each one would be a flash write
+uint32_t simGetNvsWrites();
+
+// The pixels of the last FastLED.show(), as they went to the strip
+const std::vector<CRGB>& simGetShownPixels();
+
+uint32_t simGetLedShows();
+
+uint32_t simGetBeeps();
+
+bool simIsPoweredOff();
+
+// createSprite() fails once count sprites exist, like a heap too small for more
+void simSetSpriteLimit(uint8_t count);
+
+// The snapshot System::getSnapshot() hands to the GUI, set by the script
+extern TallySnapshot simSnapshot;
@@ -0,0 +1,7 @@
+#pragma once
+// Same defaults as robtillaart/CRC, so frames built here match the device's
+#include <M5StickCPlus.h>
+
+uint16_t crc16(const uint8_t *array, uint16_t length, const uint16_t polynome = 0x8001,
+    const uint16_t startmask = 0x0000, const uint16_t endmask = 0x0000,
+    const bool reverseIn = false, const bool reverseOut = false);
@@ -0,0 +1,69 @@
+#pragma once
+// Desktop stand-in for FastLED. show() records the pixels instead of
+// sending them, see simGetShownPixels() in hal.h.
+#include <M5StickCPlus.h>
+
+struct CRGB {
+    enum HTMLColorCode {
+        Black = 0x000000,
+        Red = 0xFF0000,
+        Green = 0x008000,
+        Blue = 0x0000FF,
+        Yellow = 0xFFFF00,
+    };
+
+    CRGB() : r(0), g(0), b(0) {
+    }
+
+    CRGB(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) {
+    }
+
+    CRGB(HTMLColorCode code) : r((code >> 16) & 0xFF), g((code >> 8) & 0xFF), b(code & 0xFF) {
+    }
+
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+};
+
+inline bool operator==(const CRGB& a, const CRGB& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+#define NEOPIXEL 0
+
+class CLEDController {
+public:
+    CLEDController() : leds(NULL), count(0) {
+    }
+
+    void setLeds(CRGB *data, int length) {
+        leds = data;
+        count = length;
+    }
+
+    CRGB *leds;
+    int count;
+};
+
+class CFastLED {
+public:
+    CFastLED() : brightness(255) {
+    }
+
+    template <int Chipset, uint8_t Pin>
+    CLEDController& addLeds(CRGB *data, int length) {
+        controller.setLeds(data, length);
+        return controller;
+    }
+
+    void setBrightness(uint8_t scale) {
+        brightness = scale;
+    }
+
+    void show();
+
+    CLEDController controller;
+    uint8_t brightness;
+};
+extern CFastLED FastLED;
@@ -0,0 +1,261 @@
+#pragma once
+// Desktop stand-in for the parts of M5StickCPlus, Arduino, FreeRTOS and
+// TFT_eSPI the firmware uses. Drawing happens in memory with the same
+// pixel formats as on the device, the LCD keeps the pushed frame so it can
+// be written to an image file. Serial, beeper and power off are recorded
+// for the simulators, see hal.h.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+
+// Simulated time, advanced by the simulator
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+// GPIO, levels are set by the simulator and interrupts run synchronously
+#define IRAM_ATTR
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define CHANGE 0x03
+#define BUTTON_A_PIN 37
+#define BUTTON_B_PIN 39
+#define digitalPinToInterrupt(pin) (pin)
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t level);
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+
+class String {
+public:
+    String(const char *str = "") : str(str) {
+    }
+
+    size_t length() const {
+        return str.length();
+    }
+
+    const char *c_str() const {
+        return str.c_str();
+    }
+
+private:
+    std::string str;
+};
+
+// Serial port, the simulator reads what the firmware writes and feeds the input
+class HardwareSerial {
+public:
+    void begin(uint32_t) {
+    }
+
+    void flush() {
+    }
+
+    int available();
+
+    int read();
+
+    int availableForWrite();
+
+    size_t write(const uint8_t *data, size_t len);
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+    uint32_t getCycleCount();
+
+    uint32_t getCpuFreqMHz() {
+        return 240;
+    }
+};
+extern EspClass ESP;
+
+// FreeRTOS, single threaded: nothing ever blocks, the simulator runs the
+// display task step by hand after each GUI update
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+typedef struct SimQueue *QueueHandle_t;
+typedef struct SimQueue *SemaphoreHandle_t;
+typedef void *TaskHandle_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY 0xFFFFFFFF
+
+QueueHandle_t xQueueCreate(uint32_t length, uint32_t itemSize);
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t wait);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait);
+BaseType_t xQueuePeek(QueueHandle_t queue, void *item, TickType_t wait);
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void *item);
+SemaphoreHandle_t xSemaphoreCreateBinary();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+
+// Items waiting in all queues, or only in those of itemSize, the simulator
+// drains them after each update
+uint32_t simQueuedItemCount(uint32_t itemSize = 0);
+
+#define BLACK 0x0000
+#define WHITE 0xFFFF
+#define RED 0xF800
+#define GREEN 0x07E0
+#define YELLOW 0xFFE0
+
+#define TL_DATUM 0
+#define TR_DATUM 2
+#define MC_DATUM 4
+
+#define SIM_LCD_WIDTH 135
+#define SIM_LCD_HEIGHT 240
+
+class TFT_eSPI {
+public:
+    TFT_eSPI();
+
+    void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data);
+
+    void startWrite() {
+    }
+
+    void endWrite() {
+    }
+
+    void setSwapBytes(bool val) {
+        swapBytes = val;
+    }
+
+    bool getSwapBytes() const {
+        return swapBytes;
+    }
+
+    // Direct drawing is only used for errors, text is not rasterised
+    void fillScreen(uint32_t color);
+
+    void setTextSize(uint8_t) {
+    }
+
+    void setTextColor(uint16_t) {
+    }
+
+    int16_t drawString(const char *, int32_t, int32_t) {
+        return 0;
+    }
+
+    // Pushed frame in RGB565
+    const uint16_t *getFrame() const {
+        return frame;
+    }
+
+    uint32_t getPixelsPushed() const {
+        return pixelsPushed;
+    }
+
+private:
+    uint16_t frame[SIM_LCD_WIDTH * SIM_LCD_HEIGHT];
+    bool swapBytes;
+    uint32_t pixelsPushed;
+};
+
+// 4 bit (palette index per pixel, two per byte, left one in the high
+// nibble, rows padded to an even width) or 16 bit (RGB565 in LCD byte
+// order), like TFT_eSprite
+class TFT_eSprite {
+public:
+    TFT_eSprite(TFT_eSPI *tft);
+
+    ~TFT_eSprite();
+
+    void setColorDepth(int8_t depth) {
+        bpp = depth;
+    }
+
+    void *createSprite(int16_t w, int16_t h);
+
+    void *getPointer() {
+        return buffer;
+    }
+
+    void drawPixel(int32_t x, int32_t y, uint32_t color);
+
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+
+    void fillScreen(uint32_t color) {
+        fillRect(0, 0, width, height, color);
+    }
+
+    void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+        fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+        fillRect(x, y, 1, h, color);
+    }
+
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+
+    void drawXBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, uint16_t color);
+
+    void setTextSize(uint8_t size) {
+        textSize = size > 0 ? size : 1;
+    }
+
+    void setTextColor(uint16_t color) {
+        textColor = color;
+    }
+
+    void setTextDatum(uint8_t datum) {
+        textDatum = datum;
+    }
+
+    // Built-in 6x8 font scaled by the text size, transparent background
+    int16_t drawString(const char *str, int32_t x, int32_t y);
+
+private:
+    TFT_eSPI *tft;
+    int8_t bpp;
+    int16_t width;
+    int16_t height;
+    uint8_t *buffer;
+    uint8_t textSize;
+    uint16_t textColor;
+    uint8_t textDatum;
+};
+
+// Counts the beeps instead of sounding them
+class Beeper {
+public:
+    void setBeep(uint16_t, uint16_t) {
+    }
+
+    void beep();
+
+    void update() {
+    }
+};
+
+class AXP192 {
+public:
+    void PowerOff();
+};
+
+class M5StickCPlus {
+public:
+    void begin(bool = true, bool = true, bool = true) {
+    }
+
+    TFT_eSPI Lcd;
+    Beeper Beep;
+    AXP192 Axp;
+};
+extern M5StickCPlus M5;
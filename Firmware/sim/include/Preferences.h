@@ -0,0 +1,30 @@
+#pragma once
+// In-memory NVS. Values survive as long as the simulator runs, every write
+// is counted so the simulator can see how often flash would be written.
+#include <M5StickCPlus.h>
+
+class Preferences {
+public:
+    bool begin(const char *name, bool isReadOnly = false);
+
+    bool isKey(const char *key);
+
+    bool remove(const char *key);
+
+    uint8_t getUChar(const char *key, uint8_t defaultValue = 0);
+
+    bool getBool(const char *key, bool defaultValue = false);
+
+    size_t getBytesLength(const char *key);
+
+    size_t getBytes(const char *key, void *buf, size_t maxLen);
+
+    size_t putUChar(const char *key, uint8_t value);
+
+    size_t putBool(const char *key, bool value);
+
+    size_t putBytes(const char *key, const void *value, size_t len);
+
+private:
+    std::string name;
+};
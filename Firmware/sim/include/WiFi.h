@@ -0,0 +1,40 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef enum {
+    WIFI_IF_STA = 0,
+    WIFI_IF_AP,
+} wifi_interface_t;
+
+typedef enum {
+    WIFI_MODE_NULL = 0,
+    WIFI_MODE_STA,
+} wifi_mode_t;
+
+#define WIFI_PROTOCOL_LR 8
+
+inline esp_err_t esp_wifi_set_protocol(wifi_interface_t, uint8_t) {
+    return ESP_OK;
+}
+
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t) {
+        return true;
+    }
+
+    String macAddress() {
+        return String("24:0A:C4:00:00:01");
+    }
+
+    uint8_t *macAddress(uint8_t *mac) {
+        const uint8_t address[6] = { 0x24, 0x0A, 0xC4, 0x00, 0x00, 0x01 };
+        memcpy(mac, address, sizeof(address));
+        return mac;
+    }
+};
+extern WiFiClass WiFi;
@@ -0,0 +1,24 @@
+#pragma once
+// Desktop stand-in for ESP-NOW. Sent frames are recorded, received ones are
+// delivered by the simulator through the registered callback.
+#include <M5StickCPlus.h>
+#include <WiFi.h>
+
+#define ESP_NOW_ETH_ALEN 6
+#define ESP_NOW_KEY_LEN 16
+
+typedef struct {
+    uint8_t peer_addr[ESP_NOW_ETH_ALEN];
+    uint8_t lmk[ESP_NOW_KEY_LEN];
+    uint8_t channel;
+    wifi_interface_t ifidx;
+    bool encrypt;
+    void *priv;
+} esp_now_peer_info_t;
+
+typedef void (*esp_now_recv_cb_t)(const uint8_t *address, const uint8_t *data, int len);
+
+esp_err_t esp_now_init();
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t *peer);
+esp_err_t esp_now_send(const uint8_t *address, const uint8_t *data, size_t len);
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback);
@@ -0,0 +1,10 @@
+#pragma once
+#include <WiFi.h>
+
+typedef enum {
+    WIFI_PHY_RATE_LORA_250K = 0x29,
+} wifi_phy_rate_t;
+
+inline esp_err_t esp_wifi_internal_set_fix_rate(wifi_interface_t, bool, wifi_phy_rate_t) {
+    return ESP_OK;
+}
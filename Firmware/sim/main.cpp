@@ -0,0 +1,275 @@
+// Desktop GUI simulator. Runs the firmware's GUI layer against in-memory
+// stand-ins for the LCD and the tally task, replays a fixed script of
+// screens and writes the LCD content after each step as a PPM image.
+//
+//   gui_sim [--out DIR] [--golden DIR] [--buffers N]
+//
+// --golden compares every frame with DIR/<step>.ppm and exits with 1 if
+// any differs. The reviewed set is in golden/, ctest runs the comparison.
+// --buffers limits the display buffers that fit in the heap. One buffer
+// has to draw the same frames as two, none has to draw nothing at all.
+// The render time per step is the wall clock time of GUI::update plus the
+// display task pushes, divided by the frames actually drawn.
+#include <chrono>
+#include <string>
+#include <vector>
+#include "hal.h"
+#include "gui.h"
+#include "display.h"
+
+#define SIM_TICK 10     // ms between GUI updates, like the GUI task's vTaskDelay
+
+typedef struct {
+    std::string outDir;
+    std::string goldenDir;
+    uint32_t mismatches;
+    uint8_t bufferCount;
+} SimOptions;
+
+SimOptions options = { "sim_frames", "", 0, DISPLAY_BUFFER_COUNT };
+
+uint32_t stepFrames = 0;
+uint64_t stepNanos = 0;
+uint32_t stepNumber = 0;
+
+// Runs the GUI task and then the display task until nothing is left to push
+void run(uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += SIM_TICK) {
+        simAdvance(SIM_TICK);
+
+        uint32_t framesBefore = GUI::getRenderStats().framesRendered;
+        auto start = std::chrono::steady_clock::now();
+        GUI::update(millis());
+        while (simQueuedItemCount() > 0) {
+            Display::push(Display::waitFrame());
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        uint32_t frames = GUI::getRenderStats().framesRendered - framesBefore;
+        if (frames > 0) {
+            stepFrames += frames;
+            stepNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        }
+    }
+}
+
+void press(uint32_t ms, uint8_t pin = BUTTON_A_PIN) {
+    simSetPin(pin, LOW);
+    run(ms);
+    simSetPin(pin, HIGH);
+}
+
+void click(uint8_t pin = BUTTON_A_PIN) {
+    press(100, pin);
+    run(200);
+}
+
+void hold() {
+    press(800);
+    run(200);
+}
+
+std::vector<uint8_t> encodePpm(const uint16_t *frame) {
+    char header[32];
+    int len = snprintf(header, sizeof(header), "P6\n%d %d\n255\n", SIM_LCD_WIDTH, SIM_LCD_HEIGHT);
+    std::vector<uint8_t> out(header, header + len);
+    for (int32_t i = 0; i < SIM_LCD_WIDTH * SIM_LCD_HEIGHT; ++i) {
+        uint16_t c = frame[i];
+        out.push_back(((c >> 11) & 0x1F) * 255 / 31);
+        out.push_back(((c >> 5) & 0x3F) * 255 / 63);
+        out.push_back((c & 0x1F) * 255 / 31);
+    }
+    return out;
+}
+
+bool readFile(const std::string& path, std::vector<uint8_t>& data) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (f == NULL) {
+        return false;
+    }
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+    return true;
+}
+
+// Writes the LCD content and reports the render time since the last capture
+void capture(const char *name) {
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "%02u-%s.ppm", (unsigned)++stepNumber, name);
+
+    std::vector<uint8_t> ppm = encodePpm(M5.Lcd.getFrame());
+    std::string path = options.outDir + "/" + fileName;
+    FILE *f = fopen(path.c_str(), "wb");
+    if (f == NULL) {
+        fprintf(stderr, "cannot write %s\n", path.c_str());
+        exit(2);
+    }
+    fwrite(ppm.data(), 1, ppm.size(), f);
+    fclose(f);
+
+    const char *result = "";
+    if (!options.goldenDir.empty()) {
+        std::vector<uint8_t> golden;
+        if (!readFile(options.goldenDir + "/" + fileName, golden)) {
+            result = " missing golden";
+            options.mismatches++;
+        } else if (golden != ppm) {
+            result = " DIFFERS";
+            options.mismatches++;
+        }
+    }
+
+    printf("%-28s %3u frames %8.1f us/frame%s\n", fileName, (unsigned)stepFrames,
+        stepFrames ? stepNanos / 1000.0 / stepFrames : 0.0, result);
+    stepFrames = 0;
+    stepNanos = 0;
+}
+
+void setReceiver(uint8_t mode, uint8_t status) {
+    simSnapshot.mode = mode;
+    simSnapshot.cameraStatus[mode - 1] = status;
+    simSnapshot.currentStatus = status;
+}
+
+void setHost(uint8_t count) {
+    simSnapshot.mode = MODE_HOST;
+    simSnapshot.currentStatus = 0xff;
+    simSnapshot.cameraCount = count;
+    for (uint8_t i = 0; i < count; ++i) {
+        simSnapshot.cameraStatus[i] = i == 0 ? CAMERA_STATUS_PROGRAM : (i == 1 ? CAMERA_STATUS_PREVIEW : CAMERA_STATUS_STANDBY);
+    }
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--out") == 0) {
+            options.outDir = argv[i + 1];
+        } else if (strcmp(argv[i], "--golden") == 0) {
+            options.goldenDir = argv[i + 1];
+        } else if (strcmp(argv[i], "--buffers") == 0) {
+            options.bufferCount = atoi(argv[i + 1]);
+        }
+    }
+    std::string mkdir = "mkdir -p '" + options.outDir + "'";
+    if (system(mkdir.c_str()) != 0) {
+        return 2;
+    }
+
+    simSnapshot.mode = MODE_CAMERA_1;
+    simSnapshot.cameraCount = DEFAULT_CAMERA_COUNT;
+    simSnapshot.isAudioEnabled = true;
+    simSnapshot.brightness = 2;
+    simSnapshot.ledLayout.count = EXTERNAL_LED_DEFAULT_NUM;
+    simSnapshot.ledLayout.segmentCount = 1;
+
+    simSetSpriteLimit(options.bufferCount);
+    GUI::begin();
+
+    if (Display::getStats().bufferCount == 0) {
+        // The GUI stays off, the error on the LCD is all there is
+        run(2000);
+        press(1500);
+        uint32_t frames = GUI::getRenderStats().framesRendered;
+        printf("no display buffer, %u frames drawn\n", (unsigned)frames);
+        return frames == 0 ? 0 : 1;
+    }
+
+    run(500);
+    capture("boot");
+    run(1500);
+    capture("camera1-standby");
+
+    setReceiver(MODE_CAMERA_1, CAMERA_STATUS_PREVIEW);
+    run(100);
+    capture("camera1-preview");
+    setReceiver(MODE_CAMERA_1, CAMERA_STATUS_PROGRAM);
+    run(100);
+    capture("camera1-program");
+    simSnapshot.isTestMode = true;
+    run(100);
+    capture("camera1-test");
+    simSnapshot.isTestMode = false;
+
+    setReceiver(12, CAMERA_STATUS_PROGRAM);
+    run(100);
+    capture("camera12-program");
+    setReceiver(64, CAMERA_STATUS_PREVIEW);
+    run(100);
+    capture("camera64-preview");
+
+    const uint8_t hostCounts[] = { 4, 8, 20, 64 };
+    for (uint8_t count : hostCounts) {
+        setHost(count);
+        run(100);
+        char name[32];
+        snprintf(name, sizeof(name), "host-%u", count);
+        capture(name);
+    }
+
+    // One camera changes, only its cell is pushed
+    simSnapshot.cameraStatus[5] = CAMERA_STATUS_PROGRAM;
+    run(100);
+    capture("host-64-change");
+    strcpy(simSnapshot.errorMsg, "CRC failed");
+    run(100);
+    capture("host-error");
+    simSnapshot.errorMsg[0] = '\0';
+
+    hold();
+    capture("menu-root");
+    click();
+    capture("menu-root-mode");
+    hold();
+    capture("menu-mode-options");
+    click();
+    capture("menu-mode-options-next");
+    hold();
+    capture("menu-mode-selected");
+
+    // Root entries: <Go back, Mode, Audio, Brightness, Address, Radio, Loop, LEDs, Link, Tasks, Profile.
+    // Leaving the mode options put the cursor back on Mode.
+    for (uint8_t i = 0; i < 7; ++i) {
+        click();
+    }
+    capture("menu-root-link");
+    hold();
+    capture("menu-link");
+    hold();
+    capture("menu-link-back");
+    for (uint8_t i = 0; i < 9; ++i) {
+        click();
+    }
+    hold();
+    capture("menu-tasks");
+    hold();
+    for (uint8_t i = 0; i < 10; ++i) {
+        click();
+    }
+    hold();
+    capture("menu-profile");
+
+    // B steps back up, a double click on B jumps to the top row
+    click();
+    click();
+    click(BUTTON_B_PIN);
+    run(500);
+    capture("menu-profile-up");
+    press(100, BUTTON_B_PIN);
+    run(100);
+    click(BUTTON_B_PIN);
+    capture("menu-profile-top");
+
+    const RenderStats& stats = GUI::getRenderStats();
+    printf("%u frames drawn, %u skipped, %lu bytes to the LCD\n", (unsigned)stats.framesRendered,
+        (unsigned)stats.framesSkipped, (unsigned long)M5.Lcd.getPixelsPushed() * 2);
+
+    if (options.mismatches > 0) {
+        printf("%u frames differ from %s\n", (unsigned)options.mismatches, options.goldenDir.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,498 @@
+// Radio network simulator. Runs one transmitter and N receivers, each the
+// real tally task from its own copy of the tally_node library, in a
+// deterministic discrete-event loop. Every broadcast passes a link model per
+// receiver (loss with optional bursts, latency, jitter) and an optional
+// shared loss that hits all receivers at once, like interference at the
+// transmitter.
+//
+//   netsim [--receivers N] [--changes N] [--interval MS] [--seed N]
+//          [--loss PCT] [--burst FRAMES] [--shared-loss PCT]
+//          [--latency US] [--jitter US] [--tx-burst N] [--heartbeat MS]
+//          [--node-library PATH]
+//
+// The switcher cuts to a random camera every --interval (+-50%), the
+// previous program camera goes to preview. Latency runs from the status
+// line reaching the transmitter's serial port to the receiver's LEDs
+// showing the new state: the first LED frame that changed for it plus the
+// time the strip needs for the data, so a fade counts from its first
+// visible step. A receiver is stale while its LEDs show another state than
+// the switcher.
+#include <dlfcn.h>
+#include <unistd.h>
+#include <algorithm>
+#include <queue>
+#include <string>
+#include <vector>
+#include <CRC.h>
+#include "node.h"
+#include "system.h"
+
+#define NET_TICK 1000               // us, the tally task's 1 tick wait
+#define NET_START_TIME 200000       // us, after System::begin
+#define NET_SETTLE_TIME 1000000     // us run after the last change
+
+// WS2812 at 800 kHz plus the reset gap
+#define LED_DATA_TIME_PER_LED 30    // us
+#define LED_RESET_TIME 50           // us
+
+// Same values as in system.cpp, the simulator is the host talking to the transmitter
+#define MSG_STATUS_PACKED 0x06
+#define MSG_TX_CONFIG 0x05
+
+#define EVENT_TICK 0
+#define EVENT_RECEIVE 1
+#define EVENT_CHANGE 2
+
+#define LATENCY_BUCKET_COUNT 8
+
+const uint32_t latencyBucketLimits[LATENCY_BUCKET_COUNT] = { 5, 10, 20, 50, 100, 250, 500, UINT32_MAX };     // ms
+const char *latencyBucketNames[LATENCY_BUCKET_COUNT] = { "<5", "<10", "<20", "<50", "<100", "<250", "<500", "500+" };
+
+typedef struct {
+    uint8_t receivers;
+    uint32_t changes;
+    uint32_t interval;      // ms
+    uint32_t seed;
+    double loss;            // %
+    double burst;           // mean frames per loss burst
+    double sharedLoss;      // %
+    uint32_t latency;       // us
+    uint32_t jitter;        // us
+    uint8_t txBurst;        // 0 keeps the firmware default
+    uint16_t heartbeat;     // ms, 0 keeps the firmware default
+    std::string nodeLibrary;
+} NetOptions;
+
+NetOptions options = { 8, 200, 500, 1, 0, 1, 0, 1000, 500, 0, 0, TALLY_NODE_LIBRARY };
+
+// splitmix64, so a seed gives the same run on every machine
+class Random {
+public:
+    explicit Random(uint64_t seed) : state(seed) {
+    }
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // [0, 1)
+    double uniform() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    bool chance(double percent) {
+        return uniform() * 100 < percent;
+    }
+
+    uint32_t below(uint32_t n) {
+        return n > 0 ? next() % n : 0;
+    }
+
+private:
+    uint64_t state;
+};
+
+Random rng(1);
+
+typedef struct {
+    void *handle;
+    decltype(&nodeBegin) begin;
+    decltype(&nodeUpdate) update;
+    decltype(&nodeReceive) receive;
+    decltype(&nodeTakeSent) takeSent;
+    decltype(&nodeSerialInput) serialInput;
+    decltype(&nodeGetShownStatus) getShownStatus;
+    decltype(&nodeGetLinkStats) getLinkStats;
+} Node;
+
+typedef struct {
+    uint8_t camera;
+    bool isLinkBad;             // Gilbert-Elliott state, frames are lost while bad
+    uint8_t status;             // the switcher's status of this camera
+    uint64_t changeTime;        // us
+    bool isPending;             // the LEDs don't show the last change yet
+    uint32_t changes;
+    uint32_t superseded;        // changes overtaken by the next one before they were shown
+    std::vector<uint64_t> latencies;    // us
+    bool isStale;
+    uint64_t staleSince;        // us
+    uint64_t staleTotal;        // us
+    uint64_t staleMax;          // us
+} Receiver;
+
+typedef struct {
+    uint64_t time;              // us, the nodes only see the low 32 bits in micros()
+    uint32_t order;             // keeps events of the same time in the order they were queued
+    uint8_t type;
+    uint8_t node;
+    std::vector<uint8_t> data;
+} Event;
+
+struct EventLater {
+    bool operator()(const Event& a, const Event& b) const {
+        return a.time != b.time ? a.time > b.time : a.order > b.order;
+    }
+};
+
+std::priority_queue<Event, std::vector<Event>, EventLater> events;
+uint32_t eventOrder = 0;
+
+// Node 0 is the transmitter, node i receives camera i
+std::vector<Node> nodes;
+std::vector<Receiver> receivers;
+uint8_t programCamera = 0;
+uint32_t changesLeft = 0;
+uint64_t endTime = UINT64_MAX;
+uint32_t ledDataTime = 0;
+uint32_t framesSent = 0;
+
+void schedule(uint64_t time, uint8_t type, uint8_t node, const std::vector<uint8_t>& data = {}) {
+    events.push({ time, eventOrder++, type, node, data });
+}
+
+template <typename T>
+void resolve(Node& node, const char *name, T& fn) {
+    fn = (T)dlsym(node.handle, name);
+    if (fn == NULL) {
+        fprintf(stderr, "netsim: %s missing in %s\n", name, options.nodeLibrary.c_str());
+        exit(2);
+    }
+}
+
+bool copyFile(const std::string& from, const std::string& to) {
+    FILE *in = fopen(from.c_str(), "rb");
+    FILE *out = fopen(to.c_str(), "wb");
+    bool isOk = in != NULL && out != NULL;
+    char buf[65536];
+    size_t n;
+    while (isOk && (n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        isOk = fwrite(buf, 1, n, out) == n;
+    }
+    if (in != NULL) {
+        fclose(in);
+    }
+    if (out != NULL) {
+        fclose(out);
+    }
+    return isOk;
+}
+
+// dlopen() hands out one instance per file, so every node loads its own copy
+void loadNodes(uint8_t count) {
+    char dir[] = "/tmp/netsim-XXXXXX";
+    if (mkdtemp(dir) == NULL) {
+        perror("netsim: mkdtemp");
+        exit(2);
+    }
+
+    for (uint8_t i = 0; i < count; ++i) {
+        std::string path = std::string(dir) + "/node" + std::to_string(i) + ".so";
+        if (!copyFile(options.nodeLibrary, path)) {
+            fprintf(stderr, "netsim: cannot copy %s\n", options.nodeLibrary.c_str());
+            exit(2);
+        }
+
+        Node node;
+        node.handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        unlink(path.c_str());
+        if (node.handle == NULL) {
+            fprintf(stderr, "netsim: %s\n", dlerror());
+            exit(2);
+        }
+        resolve(node, "nodeBegin", node.begin);
+        resolve(node, "nodeUpdate", node.update);
+        resolve(node, "nodeReceive", node.receive);
+        resolve(node, "nodeTakeSent", node.takeSent);
+        resolve(node, "nodeSerialInput", node.serialInput);
+        resolve(node, "nodeGetShownStatus", node.getShownStatus);
+        resolve(node, "nodeGetLinkStats", node.getLinkStats);
+        nodes.push_back(node);
+    }
+    rmdir(dir);
+}
+
+// Sends a serial frame to the transmitter as a hex line
+void sendToHost(std::vector<uint8_t> data) {
+    data.insert(data.begin(), data.size() + 3);
+    data.resize(data.size() + 2);
+    uint16_t crc = crc16(data.data(), data.size() - 2);
+    data[data.size() - 2] = crc & 0xff;
+    data[data.size() - 1] = crc >> 8;
+
+    std::string line;
+    char hex[3];
+    for (uint8_t c : data) {
+        snprintf(hex, sizeof(hex), "%02x", c);
+        line += hex;
+    }
+    line += "\n";
+    nodes[0].serialInput((const uint8_t *)line.data(), line.size());
+}
+
+void sendStatus() {
+    std::vector<uint8_t> data = { MSG_STATUS_PACKED, options.receivers };
+    data.resize(2 + (options.receivers + 3) / 4);
+    for (const Receiver& receiver : receivers) {
+        uint8_t i = receiver.camera - 1;
+        data[2 + i / 4] |= receiver.status << ((i % 4) * 2);
+    }
+    sendToHost(data);
+}
+
+// One broadcast, judged per receiver by its link
+void transmit(uint64_t now, const std::vector<uint8_t>& frame) {
+    framesSent++;
+    if (rng.chance(options.sharedLoss)) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < receivers.size(); ++i) {
+        Receiver& receiver = receivers[i];
+        bool isLost;
+        if (options.burst > 1) {
+            // Stays bad for options.burst frames on average, bad for options.loss % of all frames
+            double toGood = 1 / options.burst;
+            double toBad = toGood * options.loss / max(100 - options.loss, 1e-9);
+            receiver.isLinkBad = rng.uniform() < (receiver.isLinkBad ? 1 - toGood : toBad);
+            isLost = receiver.isLinkBad;
+        } else {
+            isLost = rng.chance(options.loss);
+        }
+        if (!isLost) {
+            schedule(now + options.latency + rng.below(options.jitter + 1), EVENT_RECEIVE, i + 1, frame);
+        }
+    }
+}
+
+void endStale(Receiver& receiver, uint64_t time) {
+    uint64_t duration = time - receiver.staleSince;
+    receiver.staleTotal += duration;
+    receiver.staleMax = max(receiver.staleMax, duration);
+    receiver.isStale = false;
+}
+
+void checkShown(Receiver& receiver, uint8_t shown, uint64_t now) {
+    if (shown != receiver.status) {
+        return;
+    }
+    uint64_t ledTime = now + ledDataTime;
+    if (receiver.isPending) {
+        receiver.latencies.push_back(ledTime - receiver.changeTime);
+        receiver.isPending = false;
+    }
+    if (receiver.isStale) {
+        endStale(receiver, ledTime);
+    }
+}
+
+void update(uint8_t index, uint64_t now) {
+    Node& node = nodes[index];
+    node.update(now);
+
+    if (index == 0) {
+        uint8_t frame[64];
+        int len;
+        while ((len = node.takeSent(frame, sizeof(frame))) > 0) {
+            transmit(now, std::vector<uint8_t>(frame, frame + len));
+        }
+    } else {
+        checkShown(receivers[index - 1], node.getShownStatus(), now);
+    }
+}
+
+// Cut to a random camera, the previous program goes to preview
+void changeSwitcher(uint64_t now) {
+    uint8_t previewCamera = programCamera;
+    uint8_t camera = 1 + rng.below(options.receivers);
+    if (options.receivers > 1) {
+        while (camera == programCamera) {
+            camera = 1 + rng.below(options.receivers);
+        }
+    }
+    programCamera = camera;
+
+    for (uint8_t i = 0; i < receivers.size(); ++i) {
+        Receiver& receiver = receivers[i];
+        uint8_t status = CAMERA_STATUS_STANDBY;
+        if (receiver.camera == programCamera) {
+            status = CAMERA_STATUS_PROGRAM;
+        } else if (receiver.camera == previewCamera) {
+            status = CAMERA_STATUS_PREVIEW;
+        }
+        if (status == receiver.status) {
+            continue;
+        }
+
+        if (receiver.isPending) {
+            receiver.superseded++;
+        }
+        uint8_t shown = nodes[i + 1].getShownStatus();
+        receiver.status = status;
+        receiver.changeTime = now;
+        receiver.changes++;
+        receiver.isPending = shown != status;
+        if (shown != status && !receiver.isStale) {
+            receiver.isStale = true;
+            receiver.staleSince = now;
+        } else if (shown == status && receiver.isStale) {
+            // Changed back before the LEDs followed
+            endStale(receiver, now);
+        }
+    }
+    sendStatus();
+
+    if (--changesLeft > 0) {
+        uint32_t ms = options.interval / 2 + rng.below(options.interval + 1);
+        schedule(now + ms * 1000ULL, EVENT_CHANGE, 0);
+    } else {
+        endTime = now + NET_SETTLE_TIME;
+    }
+}
+
+uint64_t percentile(const std::vector<uint64_t>& sorted, uint32_t percent) {
+    return sorted.empty() ? 0 : sorted[(sorted.size() - 1) * percent / 100];
+}
+
+void printLatencyRow(const char *name, std::vector<uint64_t> latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    printf("%-8s %7.1f %7.1f %7.1f %7.1f", name, percentile(latencies, 50) / 1000.0,
+        percentile(latencies, 90) / 1000.0, percentile(latencies, 99) / 1000.0,
+        latencies.empty() ? 0.0 : latencies.back() / 1000.0);
+
+    uint32_t buckets[LATENCY_BUCKET_COUNT] = {};
+    for (uint64_t latency : latencies) {
+        uint8_t b = 0;
+        while (latency / 1000 >= latencyBucketLimits[b]) {
+            b++;
+        }
+        buckets[b]++;
+    }
+    printf("  ");
+    for (uint8_t b = 0; b < LATENCY_BUCKET_COUNT; ++b) {
+        printf(" %6u", (unsigned)buckets[b]);
+    }
+    printf("\n");
+}
+
+void printReport() {
+    printf("%u receivers, %u changes every %u ms, seed %u\n", (unsigned)options.receivers,
+        (unsigned)options.changes, (unsigned)options.interval, (unsigned)options.seed);
+    printf("loss %.1f%% in bursts of %.1f, shared loss %.1f%%, latency %u + 0..%u us, %u frames sent\n\n",
+        options.loss, options.burst, options.sharedLoss, (unsigned)options.latency, (unsigned)options.jitter,
+        (unsigned)framesSent);
+
+    printf("camera   changes shown superseded  stale total   max ms    received   lost    dup  stale\n");
+    for (uint8_t i = 0; i < receivers.size(); ++i) {
+        const Receiver& receiver = receivers[i];
+        uint32_t link[4];
+        nodes[i + 1].getLinkStats(link);
+        printf("%-8u %7u %5u %10u %11.1f %8.1f %11u %6u %6u %6u\n", (unsigned)receiver.camera,
+            (unsigned)receiver.changes, (unsigned)receiver.latencies.size(), (unsigned)receiver.superseded,
+            receiver.staleTotal / 1000.0, receiver.staleMax / 1000.0, (unsigned)link[0], (unsigned)link[1],
+            (unsigned)link[2], (unsigned)link[3]);
+    }
+
+    printf("\nlatency ms   p50     p90     p99     max  ");
+    for (uint8_t b = 0; b < LATENCY_BUCKET_COUNT; ++b) {
+        printf(" %6s", latencyBucketNames[b]);
+    }
+    printf("\n");
+    std::vector<uint64_t> all;
+    for (const Receiver& receiver : receivers) {
+        char name[16];
+        snprintf(name, sizeof(name), "%u", (unsigned)receiver.camera);
+        printLatencyRow(name, receiver.latencies);
+        all.insert(all.end(), receiver.latencies.begin(), receiver.latencies.end());
+    }
+    printLatencyRow("all", all);
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char *value = argv[i + 1];
+        if (strcmp(argv[i], "--receivers") == 0) {
+            options.receivers = max(1, min(MAX_CAMERA_COUNT, atoi(value)));
+        } else if (strcmp(argv[i], "--changes") == 0) {
+            options.changes = max(1, atoi(value));
+        } else if (strcmp(argv[i], "--interval") == 0) {
+            options.interval = max(1, atoi(value));
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            options.seed = strtoul(value, NULL, 10);
+        } else if (strcmp(argv[i], "--loss") == 0) {
+            options.loss = max(0.0, min(100.0, atof(value)));
+        } else if (strcmp(argv[i], "--burst") == 0) {
+            options.burst = max(1.0, atof(value));
+        } else if (strcmp(argv[i], "--shared-loss") == 0) {
+            options.sharedLoss = max(0.0, min(100.0, atof(value)));
+        } else if (strcmp(argv[i], "--latency") == 0) {
+            options.latency = strtoul(value, NULL, 10);
+        } else if (strcmp(argv[i], "--jitter") == 0) {
+            options.jitter = strtoul(value, NULL, 10);
+        } else if (strcmp(argv[i], "--tx-burst") == 0) {
+            options.txBurst = atoi(value);
+        } else if (strcmp(argv[i], "--heartbeat") == 0) {
+            options.heartbeat = atoi(value);
+            if (options.heartbeat < TX_BURST_INTERVAL || options.heartbeat > TX_HEARTBEAT_INTERVAL_MAX) {
+                fprintf(stderr, "netsim: --heartbeat must be %u to %u ms\n", TX_BURST_INTERVAL, TX_HEARTBEAT_INTERVAL_MAX);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--node-library") == 0) {
+            options.nodeLibrary = value;
+        } else {
+            fprintf(stderr, "netsim: unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    rng = Random(options.seed);
+    ledDataTime = EXTERNAL_LED_DEFAULT_NUM * LED_DATA_TIME_PER_LED + LED_RESET_TIME;
+
+    loadNodes(options.receivers + 1);
+    nodes[0].begin(MODE_HOST);
+    for (uint8_t i = 1; i < nodes.size(); ++i) {
+        nodes[i].begin(i);
+        Receiver receiver = {};
+        receiver.camera = i;
+        receiver.status = CAMERA_STATUS_STANDBY;
+        receivers.push_back(receiver);
+    }
+
+    if (options.txBurst > 0 || options.heartbeat > 0) {
+        uint8_t burst = options.txBurst > 0 ? options.txBurst : TX_BURST_COUNT;
+        uint16_t heartbeat = options.heartbeat > 0 ? options.heartbeat : TX_HEARTBEAT_INTERVAL;
+        sendToHost({ MSG_TX_CONFIG, burst, (uint8_t)(heartbeat & 0xff), (uint8_t)(heartbeat >> 8) });
+    }
+    sendStatus();
+
+    for (uint8_t i = 0; i < nodes.size(); ++i) {
+        schedule(NET_START_TIME, EVENT_TICK, i);
+    }
+    changesLeft = options.changes;
+    schedule(NET_START_TIME + options.interval * 1000ULL, EVENT_CHANGE, 0);
+
+    while (!events.empty() && events.top().time <= endTime) {
+        Event event = events.top();
+        events.pop();
+
+        switch (event.type) {
+        case EVENT_TICK:
+            update(event.node, event.time);
+            schedule(event.time + NET_TICK, EVENT_TICK, event.node);
+            break;
+        case EVENT_RECEIVE:
+            // The receive callback wakes the tally task right away
+            nodes[event.node].receive(event.data.data(), event.data.size());
+            update(event.node, event.time);
+            break;
+        case EVENT_CHANGE:
+            changeSwitcher(event.time);
+            break;
+        }
+    }
+
+    printReport();
+    return 0;
+}
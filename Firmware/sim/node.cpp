@@ -0,0 +1,62 @@
+#include <string>
+#include <esp_now.h>
+#include "node.h"
+#include "hal.h"
+#include "ledoutput.h"
+
+uint8_t shownStatus = 0xff;
+uint32_t nodeSentIndex = 0;
+
+const uint8_t hostAddress[ESP_NOW_ETH_ALEN] = { 0x24, 0x0a, 0xc4, 0x00, 0x00, 0x01 };
+
+NODE_API void nodeBegin(uint8_t mode) {
+    System::begin();
+    System::setMode(mode);
+}
+
+NODE_API void nodeUpdate(uint64_t us) {
+    simSetMicros(us);
+    System::update(millis());
+    while (simQueuedItemCount(sizeof(LedFrame)) > 0) {
+        LedFrame frame;
+        LedOutput::waitFrame(frame);
+        LedOutput::show(frame);
+        // The frame was rendered at the end of this update
+        shownStatus = System::getCurrentCameraStatus();
+    }
+    // Nobody reads the replies
+    simSerialTakeOutput();
+}
+
+NODE_API void nodeReceive(const uint8_t *data, int len) {
+    simRadioDeliver(hostAddress, data, len);
+}
+
+NODE_API int nodeTakeSent(uint8_t *data, int maxLen) {
+    std::vector<SimRadioFrame>& sent = simGetRadioSent();
+    if (nodeSentIndex >= sent.size()) {
+        sent.clear();
+        nodeSentIndex = 0;
+        return 0;
+    }
+    const std::vector<uint8_t>& frame = sent[nodeSentIndex++].data;
+    int len = min((int)frame.size(), maxLen);
+    memcpy(data, frame.data(), len);
+    return len;
+}
+
+NODE_API void nodeSerialInput(const uint8_t *data, int len) {
+    simSerialInput(std::string((const char *)data, len));
+}
+
+NODE_API uint8_t nodeGetShownStatus() {
+    return shownStatus;
+}
+
+NODE_API void nodeGetLinkStats(uint32_t *stats) {
+    const LinkStats *link = System::getLatestLinkStats();
+    stats[0] = link != NULL ? link->received : 0;
+    stats[1] = link != NULL ? link->lost : 0;
+    stats[2] = link != NULL ? link->duplicate : 0;
+    stats[3] = link != NULL ? link->stale : 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <stdint.h>
+
+// C interface of one tally node: the real System, settings and LED output
+// on the mocks in hal.cpp, built as a shared library. netsim loads a copy
+// of the library per node, so every node has its own globals and clock.
+#define NODE_API extern "C" __attribute__((visibility("default")))
+
+NODE_API void nodeBegin(uint8_t mode);
+
+// Sets the node's clock and runs one tally task iteration, then the LED
+// task if a frame is waiting
+NODE_API void nodeUpdate(uint64_t us);
+
+// Hands a frame to the ESP-NOW receive callback, as it came off the air
+NODE_API void nodeReceive(const uint8_t *data, int len);
+
+// Takes the oldest frame the node sent, returns its length or 0
+NODE_API int nodeTakeSent(uint8_t *data, int maxLen);
+
+NODE_API void nodeSerialInput(const uint8_t *data, int len);
+
+// Camera status the last shown LED frame was rendered for, 0xff before the first
+NODE_API uint8_t nodeGetShownStatus();
+
+// Received, lost, duplicate and stale frames of the latest link
+NODE_API void nodeGetLinkStats(uint32_t *stats);
@@ -0,0 +1,37 @@
+#include <M5StickCPlus.h>
+#include "system.h"
+#include "hal.h"
+
+// Stand-ins for the tally side, the GUI only sees the scripted snapshot
+
+TallySnapshot simSnapshot = {};
+
+void System::getSnapshot(TallySnapshot& snapshot) {
+    snapshot = simSnapshot;
+}
+
+void System::postCommand(uint8_t command, uint8_t value) {
+    switch (command) {
+    case COMMAND_SET_MODE:
+        simSnapshot.mode = value;
+        break;
+    case COMMAND_SET_AUDIO:
+        simSnapshot.isAudioEnabled = value != 0;
+        break;
+    case COMMAND_SET_BRIGHTNESS:
+        simSnapshot.brightness = value;
+        break;
+    }
+}
+
+uint8_t System::getMode() {
+    return simSnapshot.mode;
+}
+
+bool System::getIsAudioEnabled() {
+    return simSnapshot.isAudioEnabled;
+}
+
+uint8_t System::getBrightness() {
+    return simSnapshot.brightness;
+}
@@ -0,0 +1,609 @@
+// Desktop tally simulator. Runs the firmware's tally task (System, settings,
+// LED output) against the mocks in hal.cpp: a virtual clock, a fake radio,
+// a fake serial port, an in-memory NVS and a recording LED strip and beeper.
+// It replays a fixed script of radio frames and host commands, checks what
+// comes out and then measures the time of System::update. One step feeds
+// radio frames from a second thread, like the Wi-Fi task on the device.
+// Another walks the menu with button edges through the GUI task.
+//
+//   tally_sim [--bench LOOPS]
+//
+// Exits with 1 if any check fails, so it works as a regression test.
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <CRC.h>
+#include <Preferences.h>
+#include "hal.h"
+#include "ledoutput.h"
+#include "settings.h"
+#include "gui.h"
+#include "display.h"
+
+#define SIM_TICK 1      // ms between tally updates, like the tally task's 1 tick wait
+#define GUI_TICK 10     // ms between GUI updates, like the GUI task's vTaskDelay
+#define STRESS_FRAME_COUNT 50000
+#define PIPELINE_COMMAND_COUNT 20000
+#define PIPELINE_WINDOW 8   // commands in flight, like the host app
+
+// Same values as in system.cpp, the simulator speaks the wire format
+#define MSG_TEST 0x01
+#define MSG_PING 0x03
+#define MSG_PONG 0x04
+#define MSG_TX_CONFIG 0x05
+#define MSG_STATUS_PACKED 0x06
+#define MSG_ACK 0x09
+#define MSG_LED_LAYOUT 0x0B
+#define MSG_FLAG_SEQUENCE 0x40
+#define MSG_OK 0x00
+#define MSG_ERROR 0xFF
+
+const uint8_t hostAddress[6] = { 0x24, 0x0a, 0xc4, 0x00, 0x00, 0x01 };
+const uint8_t stressAddress[6] = { 0x24, 0x0a, 0xc4, 0x00, 0x00, 0x02 };
+
+uint32_t failures = 0;
+uint16_t radioSequence = 0;
+bool isGuiRunning = false;      // the menu step runs the GUI and display tasks as well
+
+// LED frames shown per color, the script clears it before each step
+std::vector<std::pair<CRGB, uint32_t>> shownColors;
+
+void check(bool isOk, const char *what) {
+    printf("%-40s %s\n", what, isOk ? "ok" : "FAILED");
+    if (!isOk) {
+        failures++;
+    }
+}
+
+// Only which channels are lit, gamma and brightness change the levels
+CRGB channelsOf(const CRGB& pixel) {
+    return CRGB(pixel.r ? 0xff : 0, pixel.g ? 0xff : 0, pixel.b ? 0xff : 0);
+}
+
+void recordShownColor() {
+    const std::vector<CRGB>& pixels = simGetShownPixels();
+    if (pixels.empty()) {
+        return;
+    }
+    CRGB color = channelsOf(pixels[0]);
+    for (auto& entry : shownColors) {
+        if (entry.first == color) {
+            entry.second++;
+            return;
+        }
+    }
+    shownColors.push_back({ color, 1 });
+}
+
+uint32_t countShown(CRGB color) {
+    color = channelsOf(color);
+    for (const auto& entry : shownColors) {
+        if (entry.first == color) {
+            return entry.second;
+        }
+    }
+    return 0;
+}
+
+// What the strip shows now, after any fade ended
+bool isShowing(CRGB color) {
+    const std::vector<CRGB>& pixels = simGetShownPixels();
+    return !pixels.empty() && channelsOf(pixels[0]) == channelsOf(color);
+}
+
+// Runs the LED task until no LED frame is left
+void showLedFrames() {
+    while (simQueuedItemCount(sizeof(LedFrame)) > 0) {
+        LedFrame frame;
+        LedOutput::waitFrame(frame);
+        LedOutput::show(frame);
+        recordShownColor();
+    }
+}
+
+// Runs the tally task and then the LED task
+void run(uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += SIM_TICK) {
+        simAdvance(SIM_TICK);
+        System::update(millis());
+        showLedFrames();
+        if (isGuiRunning && millis() % GUI_TICK == 0) {
+            GUI::update(millis());
+            while (simQueuedItemCount(sizeof(uint8_t)) > 0) {
+                Display::push(Display::waitFrame());
+            }
+        }
+    }
+}
+
+// Completes a frame whose length is in data[0] with its CRC
+void sealFrame(std::vector<uint8_t>& data) {
+    uint16_t crc = crc16(data.data(), data.size() - 2);
+    data[data.size() - 2] = crc & 0xff;
+    data[data.size() - 1] = crc >> 8;
+}
+
+// A sequenced radio frame as the host sends it, before XOR encoding
+std::vector<uint8_t> radioFrame(uint8_t type, uint16_t sequence, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> data(payload.size() + 6);
+    data[0] = data.size();
+    data[1] = type | MSG_FLAG_SEQUENCE;
+    data[2] = sequence & 0xff;
+    data[3] = sequence >> 8;
+    std::copy(payload.begin(), payload.end(), data.begin() + 4);
+    sealFrame(data);
+    return data;
+}
+
+std::vector<uint8_t> radioFrame(uint8_t type, const std::vector<uint8_t>& payload) {
+    return radioFrame(type, ++radioSequence, payload);
+}
+
+void deliver(std::vector<uint8_t> data, const uint8_t *address = hostAddress) {
+    for (uint8_t& c : data) {
+        c ^= PACKET_XOR_KEY;
+    }
+    simRadioDeliver(address, data.data(), data.size());
+}
+
+// Packed status of the first four cameras, 2 bits each
+std::vector<uint8_t> statusPayload(uint8_t camera1, uint8_t camera2 = CAMERA_STATUS_STANDBY) {
+    return { 4, (uint8_t)(camera1 | (camera2 << 2)) };
+}
+
+std::string hexLine(const std::vector<uint8_t>& data) {
+    std::string line;
+    char hex[3];
+    for (uint8_t c : data) {
+        snprintf(hex, sizeof(hex), "%02x", c);
+        line += hex;
+    }
+    return line + "\n";
+}
+
+std::vector<uint8_t> serialFrameData(uint8_t type, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> data(payload.size() + 4);
+    data[0] = data.size();
+    data[1] = type;
+    std::copy(payload.begin(), payload.end(), data.begin() + 2);
+    sealFrame(data);
+    return data;
+}
+
+// An unsequenced serial frame as a hex line
+std::string serialFrame(uint8_t type, const std::vector<uint8_t>& payload = {}) {
+    return hexLine(serialFrameData(type, payload));
+}
+
+// An unsequenced serial frame COBS encoded and terminated by 0x00
+std::string cobsFrame(uint8_t type, const std::vector<uint8_t>& payload = {}) {
+    std::vector<uint8_t> data = serialFrameData(type, payload);
+    std::string frame(1, '\0');
+    size_t codePos = 0;
+    for (uint8_t c : data) {
+        if (c != 0) {
+            frame += (char)c;
+        }
+        if (c == 0 || frame.size() - codePos == 0xFF) {
+            frame[codePos] = frame.size() - codePos;
+            codePos = frame.size();
+            frame += '\0';
+        }
+    }
+    frame[codePos] = frame.size() - codePos;
+    return frame + '\0';
+}
+
+void runReceiver() {
+    uint32_t beeps = simGetBeeps();
+    shownColors.clear();
+    deliver(radioFrame(MSG_STATUS_PACKED, statusPayload(CAMERA_STATUS_PROGRAM)));
+    run(400);
+    check(System::getCurrentCameraStatus() == CAMERA_STATUS_PROGRAM, "status program");
+    check(simGetBeeps() - beeps == 2, "program beeps twice");
+    check(isShowing(CRGB::Red), "program shows red");
+
+    beeps = simGetBeeps();
+    shownColors.clear();
+    deliver(radioFrame(MSG_STATUS_PACKED, statusPayload(CAMERA_STATUS_PREVIEW, CAMERA_STATUS_PROGRAM)));
+    run(400);
+    check(System::getCurrentCameraStatus() == CAMERA_STATUS_PREVIEW, "status preview");
+    check(System::getCameraStatus()[1] == CAMERA_STATUS_PROGRAM, "camera 2 program");
+    check(simGetBeeps() - beeps == 1, "leaving program beeps once");
+    check(isShowing(CRGB::Green), "preview shows green");
+
+    // A repeat within a burst carries the same sequence number and is dropped
+    std::vector<uint8_t> frame = radioFrame(MSG_STATUS_PACKED, statusPayload(CAMERA_STATUS_STANDBY));
+    deliver(frame);
+    deliver(frame);
+    run(10);
+    const LinkStats *link = System::getLatestLinkStats();
+    check(link != NULL && link->duplicate == 1, "duplicate counted");
+
+    // The tally task reads the clock before it drains the radio queue, so a
+    // frame can be stamped after the update's ms. That is not link loss.
+    shownColors.clear();
+    deliver(radioFrame(MSG_STATUS_PACKED, statusPayload(CAMERA_STATUS_PROGRAM)));
+    System::update(millis() - 1);
+    showLedFrames();
+    bool isBlueShown = false;
+    for (const auto& entry : shownColors) {
+        isBlueShown |= entry.first.b != 0;
+    }
+    check(!shownColors.empty() && !isBlueShown, "frame newer than the update is no link loss");
+    run(400);
+
+    shownColors.clear();
+    deliver(radioFrame(MSG_TEST, { 0xff }));
+    run(500);
+    check(System::isInTestMode(), "test mode");
+    check(countShown(CRGB::Yellow) > 0, "test shows yellow");
+    run(TEST_MODE_TIME);
+    check(!System::isInTestMode(), "test mode ends");
+
+    shownColors.clear();
+    run(LED_BLINK_PERIOD);
+    check(countShown(CRGB::Blue) > 0, "link loss blinks blue");
+}
+
+// After runRadioStress, which checks that no CRC error came up
+void runCorruptFrame() {
+    uint8_t status = System::getCurrentCameraStatus();
+    std::vector<uint8_t> frame = radioFrame(MSG_STATUS_PACKED, statusPayload(CAMERA_STATUS_PREVIEW));
+    frame[4] ^= 0x01;
+    deliver(frame);
+    run(10);
+    check(strcmp(System::getErrorMsg(), "CRC failed") == 0, "bad CRC reported");
+    check(System::getCurrentCameraStatus() == status, "bad CRC ignored");
+}
+
+// A pipelined serial frame, the request ID follows the type
+std::string sequencedSerialFrame(uint8_t type, uint16_t id, const std::vector<uint8_t>& payload) {
+    // Same layout as a sequenced radio frame
+    return hexLine(radioFrame(type, id, payload));
+}
+
+// The cumulative ID of the last MSG_ACK line in the output, -1 if there is none
+int32_t lastAckCumulative(const std::string& output) {
+    size_t end = output.rfind('\n');
+    if (end == std::string::npos) {
+        return -1;
+    }
+    size_t start = output.rfind('\n', end - 1);
+    start = start == std::string::npos ? 0 : start + 1;
+    std::string line = output.substr(start, end - start);
+    if (line.size() != 20 || line.compare(0, 4, "0a09") != 0) {
+        return -1;
+    }
+    return strtoul(line.substr(6, 2).c_str(), NULL, 16) << 8 | strtoul(line.substr(4, 2).c_str(), NULL, 16);
+}
+
+// The receive callback runs on a second thread while this one drains the
+// radio queue. Every frame must be either applied or counted as dropped,
+// none may arrive torn (the CRC would fail) or out of order (stale).
+void runRadioStress() {
+    std::vector<std::vector<uint8_t>> frames;
+    for (uint32_t i = 0; i < STRESS_FRAME_COUNT; ++i) {
+        frames.push_back(radioFrame(MSG_STATUS_PACKED, i + 1, statusPayload(i % 3)));
+    }
+
+    uint32_t dropped = System::getRadioFramesDropped();
+    std::atomic<bool> isDone(false);
+    std::thread wifiTask([&]() {
+        // Bursts longer than the queue, so some frames are dropped
+        for (uint32_t i = 0; i < frames.size(); ++i) {
+            deliver(frames[i], stressAddress);
+            if (i % 32 == 31) {
+                std::this_thread::yield();
+            }
+        }
+        isDone = true;
+    });
+    while (!isDone) {
+        run(1);
+    }
+    wifiTask.join();
+    run(1);
+    dropped = System::getRadioFramesDropped() - dropped;
+
+    // The last frame after the queue is empty, so a drop at the end shows as a gap
+    deliver(radioFrame(MSG_STATUS_PACKED, STRESS_FRAME_COUNT + 1, statusPayload(CAMERA_STATUS_PROGRAM)), stressAddress);
+    run(1);
+
+    const LinkStats *link = System::getLatestLinkStats();
+    check(link != NULL && memcmp(link->address, stressAddress, 6) == 0, "stress link tracked");
+    if (link != NULL) {
+        printf("%u frames from a second thread, %u dropped on a full queue\n", (unsigned)STRESS_FRAME_COUNT + 1,
+            (unsigned)dropped);
+        check(link->received + dropped == STRESS_FRAME_COUNT + 1, "every frame applied or dropped");
+        check(link->lost == dropped, "only dropped frames missing");
+        check(link->stale == 0 && link->duplicate == 0, "frames stay in order");
+    }
+    check(strcmp(System::getErrorMsg(), "CRC failed") != 0, "no torn frames");
+    check(System::getCurrentCameraStatus() == CAMERA_STATUS_PROGRAM, "last frame applied");
+}
+
+void runHost() {
+    System::setMode(MODE_HOST);
+    run(10);
+    simSerialTakeOutput();
+
+    simSerialInput(serialFrame(MSG_PING));
+    run(1);
+    check(simSerialTakeOutput() == serialFrame(MSG_PONG), "ping answered");
+
+    // A status change goes out as a burst right away
+    simGetRadioSent().clear();
+    uint32_t fedTime = micros();
+    simSerialInput(serialFrame(MSG_STATUS_PACKED, statusPayload(CAMERA_STATUS_PREVIEW, CAMERA_STATUS_PROGRAM)));
+    run(TX_BURST_COUNT * TX_BURST_INTERVAL + 5);
+    check(simSerialTakeOutput() == serialFrame(MSG_OK), "status acknowledged");
+
+    std::vector<SimRadioFrame>& sent = simGetRadioSent();
+    check(sent.size() == TX_BURST_COUNT, "status burst sent");
+    bool isSameFrame = !sent.empty();
+    for (const SimRadioFrame& frame : sent) {
+        isSameFrame &= frame.data == sent[0].data;
+    }
+    check(isSameFrame, "burst repeats one sequence number");
+    if (!sent.empty()) {
+        std::vector<uint8_t> data = sent[0].data;
+        for (uint8_t& c : data) {
+            c ^= PACKET_XOR_KEY;
+        }
+        check(data.size() == 8 && data[1] == (MSG_STATUS_PACKED | MSG_FLAG_SEQUENCE) && data[4] == 4
+            && data[5] == (CAMERA_STATUS_PREVIEW | (CAMERA_STATUS_PROGRAM << 2)), "status frame content");
+        printf("serial to radio latency %lu us\n", (unsigned long)(sent[0].time - fedTime));
+    }
+
+    simGetRadioSent().clear();
+    run(TX_HEARTBEAT_INTERVAL * 4);
+    check(sent.size() == 4, "heartbeat every 250 ms");
+
+    // A heartbeat too slow for the receivers' link loss timeout is refused
+    simSerialInput(serialFrame(MSG_TX_CONFIG, { TX_BURST_COUNT, 0xe8, 0x03 }));
+    run(1);
+    check(simSerialTakeOutput() == serialFrame(MSG_ERROR), "1000 ms heartbeat refused");
+    simGetRadioSent().clear();
+    run(TX_HEARTBEAT_INTERVAL * 4);
+    check(sent.size() == 4, "heartbeat unchanged");
+
+    simSerialInput(serialFrame(MSG_TX_CONFIG, { TX_BURST_COUNT, 100, 0 }));
+    run(1);
+    check(simSerialTakeOutput() == serialFrame(MSG_OK), "100 ms heartbeat accepted");
+    simGetRadioSent().clear();
+    run(1000);
+    check(sent.size() == 10, "heartbeat every 100 ms");
+    simSerialInput(serialFrame(MSG_TX_CONFIG, { TX_BURST_COUNT, TX_HEARTBEAT_INTERVAL, 0 }));
+    run(1);
+    simSerialTakeOutput();
+
+    const LedLayout& layout = System::getLedLayout();
+    std::vector<uint8_t> layoutPayload = { layout.count, layout.segmentCount };
+    for (uint8_t i = 0; i < layout.segmentCount; ++i) {
+        layoutPayload.insert(layoutPayload.end(), { layout.segments[i].start, layout.segments[i].length,
+            layout.segments[i].role });
+    }
+    simSerialInput(serialFrame(MSG_LED_LAYOUT));
+    run(1);
+    check(simSerialTakeOutput() == serialFrame(MSG_LED_LAYOUT, layoutPayload), "LED layout read back");
+}
+
+// Pipelined status commands, a window full per loop, every loop must ack
+// all of them. Then replays from before the window and IDs far ahead,
+// which must neither be executed nor move the cumulative ack.
+void runPipelinedCommands() {
+    simSerialInput(serialFrame(MSG_PING));
+    run(1);
+    simSerialTakeOutput();
+
+    bool isAllAcked = true;
+    uint64_t nanos = 0;
+    uint16_t id = 0;
+    while (id < PIPELINE_COMMAND_COUNT) {
+        std::string batch;
+        for (uint8_t i = 0; i < PIPELINE_WINDOW; ++i) {
+            ++id;
+            batch += sequencedSerialFrame(MSG_STATUS_PACKED, id, statusPayload(id % 3));
+        }
+        simSerialInput(batch);
+
+        simAdvance(SIM_TICK);
+        auto start = std::chrono::steady_clock::now();
+        System::update(millis());
+        auto end = std::chrono::steady_clock::now();
+        nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        isAllAcked &= lastAckCumulative(simSerialTakeOutput()) == id;
+    }
+    check(isAllAcked, "pipelined commands acked per loop");
+    check(System::getCameraStatus()[0] == id % 3, "latest pipelined status applied");
+    printf("%u pipelined commands, %.0f commands/s through System::update\n", (unsigned)id, id * 1e9 / nanos);
+
+    uint8_t status = System::getCameraStatus()[0];
+    simSerialInput(sequencedSerialFrame(MSG_STATUS_PACKED, id - 100, statusPayload((status + 1) % 3)));
+    run(1);
+    check(lastAckCumulative(simSerialTakeOutput()) == id && System::getCameraStatus()[0] == status,
+        "replay before the window rejected");
+
+    simSerialInput(sequencedSerialFrame(MSG_STATUS_PACKED, id + 100, statusPayload((status + 1) % 3)));
+    run(1);
+    check(lastAckCumulative(simSerialTakeOutput()) == id && System::getCameraStatus()[0] == status,
+        "ID past the window rejected");
+
+    simSerialInput(sequencedSerialFrame(MSG_STATUS_PACKED, id + 1, statusPayload((status + 1) % 3)));
+    run(1);
+    check(lastAckCumulative(simSerialTakeOutput()) == id + 1 && System::getCameraStatus()[0] == (status + 1) % 3,
+        "window continues after rejects");
+}
+
+// A COBS frame whose data holds "\nAA\n", a valid hex line of its own, must
+// not be cut at the 0x0A. A hex line still works right after it.
+void runBinaryFraming() {
+    std::vector<uint8_t> status = { 16, 0x0A, 'A', 'A', 0x0A };
+    simSerialInput(std::string(1, '\0') + cobsFrame(MSG_STATUS_PACKED, status));
+    run(1);
+    check(simSerialTakeOutput() == cobsFrame(MSG_OK), "COBS frame with 0x0A acknowledged");
+    const uint8_t *cameras = System::getCameraStatus();
+    bool isApplied = true;
+    for (uint8_t i = 0; i < 16; ++i) {
+        isApplied &= cameras[i] == ((status[1 + i / 4] >> ((i % 4) * 2)) & 0x03);
+    }
+    check(isApplied, "COBS frame with 0x0A applied");
+
+    simSerialInput(serialFrame(MSG_PING));
+    run(1);
+    check(simSerialTakeOutput() == serialFrame(MSG_PONG), "hex line after COBS frames");
+}
+
+void press(uint32_t ms, uint8_t pin = BUTTON_A_PIN) {
+    simSetPin(pin, LOW);
+    run(ms);
+    simSetPin(pin, HIGH);
+}
+
+// Waits out the double click time, so the next click on B is a single one
+void click(uint8_t pin = BUTTON_A_PIN) {
+    press(100, pin);
+    run(500);
+}
+
+void hold() {
+    press(800);
+    run(100);
+}
+
+bool isInMenu(const char *name) {
+    const char *menu = GUI::getMenuName();
+    return menu != NULL && strcmp(menu, name) == 0;
+}
+
+// Button edges through ButtonInput and the GUI: the menu walks to the mode
+// options and picks camera 2, which the tally task applies and commits to
+// NVS once SETTINGS_COMMIT_DELAY has passed.
+void runMenu() {
+    System::setMode(MODE_CAMERA_1);
+    run(SETTINGS_COMMIT_DELAY + 10);
+    uint32_t writes = simGetNvsWrites();
+
+    GUI::begin();
+    isGuiRunning = true;
+    run(2000);
+    check(GUI::getMenuName() == NULL, "GUI boots outside the menu");
+
+    hold();
+    check(isInMenu("Menu") && GUI::getMenuSelection() == 0, "hold A opens the menu");
+    click();
+    check(isInMenu("Menu") && GUI::getMenuSelection() == 1, "click A moves down");
+    hold();
+    check(isInMenu("Mode") && GUI::getMenuSelection() == MODE_CAMERA_1, "options open on the current mode");
+    click();
+    check(isInMenu("Mode") && GUI::getMenuSelection() == MODE_CAMERA_2, "click A moves to the next option");
+    hold();
+    check(isInMenu("Menu") && GUI::getMenuSelection() == 1, "confirming returns to the mode row");
+    check(System::getMode() == MODE_CAMERA_2, "selected mode applied");
+    check(SettingsStore::getStats().isDirty && simGetNvsWrites() == writes, "menu change commit is delayed");
+
+    press(100, BUTTON_B_PIN);
+    run(2 * GUI_TICK);
+    check(GUI::getMenuSelection() == 0, "click B moves up on release");
+    run(500);
+    click();
+    click();
+    click();
+    check(GUI::getMenuSelection() == 3, "clicks on A count rows");
+    press(100, BUTTON_B_PIN);
+    run(100);
+    click(BUTTON_B_PIN);
+    check(GUI::getMenuSelection() == 0, "double click B jumps to the top");
+    hold();
+    check(GUI::getMenuName() == NULL, "go back leaves the menu");
+
+    run(SETTINGS_COMMIT_DELAY);
+    Preferences preferences;
+    Settings stored = {};
+    preferences.begin("pref_lib", true);
+    preferences.getBytes("p_settings", &stored, sizeof(stored));
+    check(simGetNvsWrites() == writes + 1 && stored.mode == MODE_CAMERA_2, "menu change committed to NVS");
+    isGuiRunning = false;
+}
+
+void runSettings() {
+    uint32_t writes = simGetNvsWrites();
+    System::setBrightness(4);
+    // The tally task's ms can be older than the change
+    System::update(millis() - 1);
+    check(simGetNvsWrites() == writes, "change newer than the update is not committed");
+    run(SETTINGS_COMMIT_DELAY / 2);
+    check(SettingsStore::getStats().isDirty && simGetNvsWrites() == writes, "settings commit is delayed");
+    System::setBrightness(3);
+    run(SETTINGS_COMMIT_DELAY + 10);
+    check(!SettingsStore::getStats().isDirty && simGetNvsWrites() == writes + 1, "one commit for two changes");
+
+    System::setIsAudioEnabled(false);
+    System::powerOff();
+    check(simIsPoweredOff() && simGetNvsWrites() == writes + 2, "power off commits");
+}
+
+// Wall clock time of System::update without and with a radio frame to process
+void runBenchmark(uint32_t loops) {
+    System::setMode(MODE_CAMERA_1);
+    std::vector<uint8_t> frame = radioFrame(MSG_STATUS_PACKED, statusPayload(CAMERA_STATUS_STANDBY));
+
+    for (int withFrame = 0; withFrame < 2; ++withFrame) {
+        uint64_t nanos = 0;
+        for (uint32_t i = 0; i < loops; ++i) {
+            simAdvance(SIM_TICK);
+            if (withFrame) {
+                frame = radioFrame(MSG_STATUS_PACKED, statusPayload(i & 1 ? CAMERA_STATUS_PREVIEW : CAMERA_STATUS_STANDBY));
+                deliver(frame);
+            }
+            auto start = std::chrono::steady_clock::now();
+            System::update(millis());
+            auto end = std::chrono::steady_clock::now();
+            nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+            while (simQueuedItemCount(sizeof(LedFrame)) > 0) {
+                LedFrame ledFrame;
+                LedOutput::waitFrame(ledFrame);
+                LedOutput::show(ledFrame);
+            }
+        }
+        printf("System::update %s %8.1f ns\n", withFrame ? "with a frame" : "idle        ", (double)nanos / loops);
+    }
+}
+
+int main(int argc, char **argv) {
+    uint32_t benchLoops = 100000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--bench") == 0) {
+            benchLoops = strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+
+    System::begin();
+    run(100);
+    check(System::getMode() == MODE_CAMERA_1, "default mode");
+    check(simGetShownPixels().size() == EXTERNAL_LED_DEFAULT_NUM, "default strip length");
+
+    runReceiver();
+    runRadioStress();
+    runCorruptFrame();
+    runHost();
+    runPipelinedCommands();
+    runBinaryFraming();
+    runMenu();
+    runSettings();
+
+    if (benchLoops > 0) {
+        runBenchmark(benchLoops);
+    }
+
+    if (failures > 0) {
+        printf("%u checks failed\n", (unsigned)failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,14 @@
+#include "tasks.h"
+
+// The simulators run everything on one thread, there is no task to wake
+// and nothing to measure
+
+void Tasks::notifyTally() {
+}
+
+void Tasks::getStats(uint8_t task, TaskStats& stats) {
+    stats.name = TaskNames[task];
+    stats.stackHighWater = 0;
+    stats.load = 0;
+    stats.maxUpdateTime = 0;
+}
@@ -2,7 +2,6 @@
 #define _MENUITEM_HH
 
 #include <M5StickCPlus.h>
-#include <functional>
 
 enum MenuType
 {
@@ -11,47 +10,40 @@ enum MenuType
     eSelection = 2
 };
 
-class MenuItem;
-typedef std::function<void (MenuItem *item, bool isManually)> MenuCallback;
+#define MENU_NO_STATE 0xff
 
-class MenuItem
+// Gets the new selection of a selection item, 0 for a node
+typedef void (*MenuAction)(uint8_t selection);
+
+// Menu entries are constexpr tables, so the whole tree is in flash and
+// nothing is allocated at boot. The children of a node are one contiguous
+// array. The only runtime state, the selection of a selection item, is
+// kept by the owner of the tree in a slot per stateIndex.
+struct MenuItem
 {
-public:
     const char *name;
     const char *desc;
     MenuType type;
-    MenuCallback callback;
-
-    const char **options;
-    int8_t numOptions;
-    int8_t selection;
+    MenuAction action;
 
-    MenuItem *parent;
-    MenuItem **children;
+    const MenuItem *children;
     uint8_t numChildren;
 
-    uint32_t userData;
-    bool isModifiable;
-
-    MenuItem(const char *name, const char *desc = NULL, MenuType type = eNode, MenuItem *parent = NULL);
-
-    ~MenuItem();
-
-    void addChild(MenuItem *item);
-
-    void removeChild(MenuItem *item);
-
-    bool hasChild(MenuItem *item);
-
-    void setDesc(const char *desc);
+    const char *const *options;
+    uint8_t numOptions;
+    uint8_t stateIndex;
+};
 
-    void setTypeToSelection(int8_t selection, const char **options = NULL, int8_t numOptions = 0);
+#define MENU_ARRAY_SIZE(array) (sizeof(array) / sizeof((array)[0]))
 
-    void addOption(const char *option);
+// A leaf, desc may point to a buffer that is updated while the menu is open
+#define MENU_NODE(name, desc, action) \
+    { name, desc, eNode, action, NULL, 0, NULL, 0, MENU_NO_STATE }
 
-    void setCallback(const MenuCallback& callback);
+#define MENU_PARENT(name, children) \
+    { name, NULL, eNode, NULL, children, MENU_ARRAY_SIZE(children), NULL, 0, MENU_NO_STATE }
 
-    int8_t getChildIndex(MenuItem *item);
-};
+#define MENU_SELECTION(name, options, stateIndex, action) \
+    { name, NULL, eSelection, action, NULL, 0, options, MENU_ARRAY_SIZE(options), stateIndex }
 
-#endif
\ No newline at end of file
+#endif
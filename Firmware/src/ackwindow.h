@@ -0,0 +1,98 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+#define ACK_WINDOW_SIZE 32      // request IDs tracked beyond the cumulative ack
+
+#define ACK_NEWEST 0            // newer than anything received so far
+#define ACK_LATE 1              // not seen before, but a newer one already arrived
+#define ACK_DUPLICATE 2         // already received, only needs to be acked again
+#define ACK_REJECTED 3          // outside the window, neither executed nor acked
+
+// Tracks the request IDs of pipelined host commands. The cumulative ID
+// covers every command up to and including it, bit i of the selective
+// mask covers cumulative + 2 + i, received after a gap.
+class AckWindow {
+public:
+    AckWindow()
+        : cumulative(0),
+        selective(0),
+        highest(0),
+        hasBase(false),
+        isPending(false) {
+    }
+
+    // Forget the previous session, the next ID starts a new window
+    void reset() {
+        hasBase = false;
+        selective = 0;
+        isPending = false;
+    }
+
+    uint8_t receive(uint16_t id) {
+        isPending = true;
+
+        int16_t diff = (int16_t)(id - cumulative);
+        if (!hasBase) {
+            // First command of the session, the window starts here
+            cumulative = id;
+            highest = id;
+            selective = 0;
+            hasBase = true;
+            return ACK_NEWEST;
+        }
+
+        // A replay from before the window must not become the new base, and
+        // one too far ahead must not ack the IDs in between. A host that
+        // really lost track starts over with MSG_PING.
+        if (diff > ACK_WINDOW_SIZE + 1 || diff < -ACK_WINDOW_SIZE) {
+            return ACK_REJECTED;
+        }
+
+        if (diff <= 0) {
+            return ACK_DUPLICATE;
+        }
+
+        if (diff == 1) {
+            cumulative = id;
+            while (selective & 1) {
+                selective >>= 1;
+                cumulative++;
+            }
+            selective >>= 1;
+        } else {
+            uint32_t bit = 1UL << (diff - 2);
+            if (selective & bit) {
+                return ACK_DUPLICATE;
+            }
+            selective |= bit;
+        }
+
+        if ((int16_t)(id - highest) > 0) {
+            highest = id;
+            return ACK_NEWEST;
+        }
+        return ACK_LATE;
+    }
+
+    // True once after new commands arrived, the caller then sends an ack
+    bool takePending() {
+        bool ret = isPending;
+        isPending = false;
+        return ret;
+    }
+
+    uint16_t getCumulative() const {
+        return cumulative;
+    }
+
+    uint32_t getSelective() const {
+        return selective;
+    }
+
+private:
+    uint16_t cumulative;
+    uint32_t selective;
+    uint16_t highest;
+    bool hasBase;
+    bool isPending;
+};
@@ -0,0 +1,65 @@
+#include "buttoninput.h"
+#include "spscqueue.h"
+
+const uint8_t ButtonPins[BUTTON_COUNT] = { BUTTON_A_PIN, BUTTON_B_PIN };
+
+// Clicks are reported right on release, B also reports double clicks
+ButtonReader buttonReaders[BUTTON_COUNT] = { ButtonReader(false), ButtonReader(true) };
+
+SpscQueue<ButtonEdge, BUTTON_EDGE_QUEUE_SIZE> buttonEdgeQueue;
+std::atomic<uint32_t> buttonEdgesDropped(0);
+ButtonStats buttonStats = { 0, 0, 0, 0 };
+
+// The buttons are active low. GPIO 39 can see spurious interrupts while
+// the ADC or Wi-Fi powers up, the level read here makes those edges
+// repeat the current state and ButtonReader ignores them.
+void IRAM_ATTR pushButtonEdge(uint8_t button) {
+    ButtonEdge edge = { button, digitalRead(ButtonPins[button]) == LOW, (uint32_t)micros() };
+    if (!buttonEdgeQueue.push(edge)) {
+        buttonEdgesDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void IRAM_ATTR onButtonAEdge() {
+    pushButtonEdge(BUTTON_A);
+}
+
+void IRAM_ATTR onButtonBEdge() {
+    pushButtonEdge(BUTTON_B);
+}
+
+void ButtonInput::begin() {
+    for (uint8_t i = 0; i < BUTTON_COUNT; ++i) {
+        pinMode(ButtonPins[i], INPUT);
+    }
+    attachInterrupt(digitalPinToInterrupt(BUTTON_A_PIN), onButtonAEdge, CHANGE);
+    attachInterrupt(digitalPinToInterrupt(BUTTON_B_PIN), onButtonBEdge, CHANGE);
+}
+
+void ButtonInput::update() {
+    ButtonEdge edge;
+    while (buttonEdgeQueue.pop(edge)) {
+        buttonReaders[edge.button].addEdge(edge.isDown, edge.time);
+
+        // Read after the pop, the edge may have come in since update() started
+        buttonStats.edges++;
+        buttonStats.lastLatency = micros() - edge.time;
+        if (buttonStats.lastLatency > buttonStats.maxLatency) {
+            buttonStats.maxLatency = buttonStats.lastLatency;
+        }
+    }
+    buttonStats.dropped = buttonEdgesDropped.load(std::memory_order_relaxed);
+
+    uint32_t us = micros();
+    for (uint8_t i = 0; i < BUTTON_COUNT; ++i) {
+        buttonReaders[i].update(us, digitalRead(ButtonPins[i]) == LOW);
+    }
+}
+
+ButtonReader& ButtonInput::get(uint8_t button) {
+    return buttonReaders[button];
+}
+
+const ButtonStats& ButtonInput::getStats() {
+    return buttonStats;
+}
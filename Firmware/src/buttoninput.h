@@ -0,0 +1,38 @@
+#pragma once
+#include <M5StickCPlus.h>
+#include "buttonreader.h"
+
+#define BUTTON_A 0
+#define BUTTON_B 1
+#define BUTTON_COUNT 2
+
+#define BUTTON_EDGE_QUEUE_SIZE 16
+
+typedef struct {
+    uint8_t button;
+    bool isDown;
+    uint32_t time;      // us, taken in the interrupt
+} ButtonEdge;
+
+typedef struct {
+    uint32_t edges;
+    uint32_t dropped;       // edges lost to a full queue
+    uint32_t lastLatency;   // us from the interrupt to update()
+    uint32_t maxLatency;
+} ButtonStats;
+
+// Edge interrupt driver of the two buttons. The interrupts timestamp every
+// edge into a ring buffer, update() hands them on to a ButtonReader per
+// button. Input latency is set by how often update() runs, not by a
+// polling interval.
+class ButtonInput {
+public:
+    static void begin();
+
+    // GUI task only
+    static void update();
+
+    static ButtonReader& get(uint8_t button);
+
+    static const ButtonStats& getStats();
+};
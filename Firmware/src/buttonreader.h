@@ -1,10 +1,14 @@
 #pragma once
 #include <M5StickCPlus.h>
 
-#define ENC_BUTTONINTERVAL    50  // check button every x milliseconds, also debouce time
-#define ENC_DOUBLECLICKTIME  600  // second click within 600ms
-#define ENC_HOLDTIME        500  // report held button after 1.2s
+#define BUTTON_DEBOUNCE_TIME 20000      // us an edge has to be apart from the last accepted one
+#define BUTTON_DOUBLECLICK_TIME 400000  // us after a click in which a second one counts as double click
+#define BUTTON_HOLD_TIME 500000         // us pressed before the button reports held
 
+// Classifies the edges of one button by their timestamps. Edges come from
+// the interrupt (addEdge), update() handles what only the passing of time
+// decides: holds, the end of the double click window and an edge lost to
+// debouncing. All times are in microseconds.
 class ButtonReader {
 public:
     typedef enum Button_e {
@@ -20,15 +24,19 @@ public:
         
     } ButtonState;
 
-    ButtonReader(Button *_button)
-        : button(_button),
-        keyDownTicks(0),
-        doubleClickTicks(0),
-        lastButtonCheck(0),
-        doubleClickEnabled(false),
+    // A click is reported right on release. With double clicks a second
+    // click within BUTTON_DOUBLECLICK_TIME reports DoubleClicked instead.
+    ButtonReader(bool _isDoubleClickEnabled = false)
+        : isDoubleClickEnabled(_isDoubleClickEnabled),
+        isDown(false),
+        isClickPending(false),
+        lastEdgeTime(0),
+        downTime(0),
+        releaseTime(0),
         value(Open) {
     }
 
+    // Held is reported until the button is released, everything else once
     ButtonState get() {
         ButtonReader::ButtonState ret = value;
         if (value != ButtonReader::Held) {
@@ -37,55 +45,52 @@ public:
         return ret;
     }
 
-    void update() {
-        unsigned long now = millis();
+    void addEdge(bool isEdgeDown, uint32_t us) {
+        if (isEdgeDown == isDown || us - lastEdgeTime < BUTTON_DEBOUNCE_TIME) {
+            return;
+        }
+        isDown = isEdgeDown;
+        lastEdgeTime = us;
 
-        lastButtonCheck = now;
-        auto state = button->read();
-        
-        if (state) { // key is down
-            keyDownTicks++;
-            if (keyDownTicks > (ENC_HOLDTIME / ENC_BUTTONINTERVAL)) {
-                value = Held;
-            }
+        if (isDown) {
+            downTime = us;
+            return;
         }
 
-        if (!state) { // key is now up
-            if (keyDownTicks /*> ENC_BUTTONINTERVAL*/) {
-                if (value == Held) {
-                    value = Released;
-                    doubleClickTicks = 0;
-                }
-                else {
-                    #define ENC_SINGLECLICKONLY 1
-                    if (doubleClickTicks > ENC_SINGLECLICKONLY) {   // prevent trigger in single click mode
-                        if (doubleClickTicks < (ENC_DOUBLECLICKTIME / ENC_BUTTONINTERVAL)) {
-                            value = DoubleClicked;
-                            doubleClickTicks = 0;
-                        }
-                    }
-                    else {
-                        doubleClickTicks = (doubleClickEnabled) ? (ENC_DOUBLECLICKTIME / ENC_BUTTONINTERVAL) : ENC_SINGLECLICKONLY;
-                    }
-                }
-            }
+        if (value == Held) {
+            value = Released;
+            isClickPending = false;
+        } else if (isClickPending && us - releaseTime < BUTTON_DOUBLECLICK_TIME) {
+            value = DoubleClicked;
+            isClickPending = false;
+        } else {
+            value = Clicked;
+            isClickPending = isDoubleClickEnabled;
+            releaseTime = us;
+        }
+    }
 
-            keyDownTicks = 0;
+    // isPinDown is the current level, it catches up on an edge the
+    // debouncing dropped, e.g. a press shorter than BUTTON_DEBOUNCE_TIME
+    void update(uint32_t us, bool isPinDown) {
+        if (isPinDown != isDown && us - lastEdgeTime >= BUTTON_DEBOUNCE_TIME) {
+            addEdge(isPinDown, us);
         }
-    
-        if (doubleClickTicks > 0) {
-            //doubleClickTicks--;
-            if (--doubleClickTicks == 0) {
-                value = Clicked;
-            }
+
+        if (isDown && us - downTime >= BUTTON_HOLD_TIME) {
+            value = Held;
+            isClickPending = false;
+        } else if (isClickPending && !isDown && us - releaseTime >= BUTTON_DOUBLECLICK_TIME) {
+            isClickPending = false;
         }
     }
 
 private:
-    uint16_t keyDownTicks;
-    uint8_t doubleClickTicks;
-    unsigned long lastButtonCheck;
-    volatile ButtonState value;
-    bool doubleClickEnabled;
-    Button *button;
-};
\ No newline at end of file
+    bool isDoubleClickEnabled;
+    bool isDown;
+    bool isClickPending;
+    uint32_t lastEdgeTime;
+    uint32_t downTime;
+    uint32_t releaseTime;
+    ButtonState value;
+};
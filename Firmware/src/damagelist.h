@@ -0,0 +1,112 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+#define DAMAGE_MAX_RECTS 8
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+} DamageRect;
+
+// Screen regions changed since the last pushed frame. Overlapping or
+// touching rectangles are merged as they are added, when the list is full
+// the new one joins the rectangle it grows the least.
+class DamageList {
+public:
+    DamageList(int16_t width, int16_t height) : width(width), height(height), count(0) {
+    }
+
+    void clear() {
+        count = 0;
+    }
+
+    void addAll() {
+        rects[0] = { 0, 0, width, height };
+        count = 1;
+    }
+
+    void add(int16_t x, int16_t y, int16_t w, int16_t h) {
+        // Clip to the screen
+        if (x < 0) {
+            w += x;
+            x = 0;
+        }
+        if (y < 0) {
+            h += y;
+            y = 0;
+        }
+        w = min(w, (int16_t)(width - x));
+        h = min(h, (int16_t)(height - y));
+        if (w <= 0 || h <= 0) {
+            return;
+        }
+
+        DamageRect rect = { x, y, w, h };
+        // Merging can make the result touch another rectangle, keep going until nothing does
+        for (uint8_t i = 0; i < count;) {
+            if (isTouching(rects[i], rect)) {
+                rect = join(rects[i], rect);
+                rects[i] = rects[--count];
+                i = 0;
+            } else {
+                ++i;
+            }
+        }
+
+        if (count < DAMAGE_MAX_RECTS) {
+            rects[count++] = rect;
+            return;
+        }
+
+        uint8_t best = 0;
+        int32_t bestGrowth = INT32_MAX;
+        for (uint8_t i = 0; i < count; ++i) {
+            int32_t growth = area(join(rects[i], rect)) - area(rects[i]);
+            if (growth < bestGrowth) {
+                best = i;
+                bestGrowth = growth;
+            }
+        }
+        rects[best] = join(rects[best], rect);
+    }
+
+    uint8_t getCount() const {
+        return count;
+    }
+
+    const DamageRect& get(uint8_t index) const {
+        return rects[index];
+    }
+
+    uint32_t getPixelCount() const {
+        uint32_t pixels = 0;
+        for (uint8_t i = 0; i < count; ++i) {
+            pixels += area(rects[i]);
+        }
+        return pixels;
+    }
+
+private:
+    static bool isTouching(const DamageRect& a, const DamageRect& b) {
+        return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h && b.y <= a.y + a.h;
+    }
+
+    static DamageRect join(const DamageRect& a, const DamageRect& b) {
+        int16_t x = min(a.x, b.x);
+        int16_t y = min(a.y, b.y);
+        int16_t w = max(a.x + a.w, b.x + b.w) - x;
+        int16_t h = max(a.y + a.h, b.y + b.h) - y;
+        return { x, y, w, h };
+    }
+
+    static int32_t area(const DamageRect& rect) {
+        return (int32_t)rect.w * rect.h;
+    }
+
+    int16_t width;
+    int16_t height;
+    DamageRect rects[DAMAGE_MAX_RECTS];
+    uint8_t count;
+};
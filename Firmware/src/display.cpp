@@ -0,0 +1,160 @@
+#include "display.h"
+#include "profiler.h"
+
+typedef struct {
+    TFT_eSprite *sprite;
+    DamageList *damage;
+    SemaphoreHandle_t isFree;
+} DisplayBuffer;
+
+DisplayBuffer displayBuffers[DISPLAY_BUFFER_COUNT];
+uint8_t displayBufferCount = 0;
+uint8_t backBuffer = 0;
+
+QueueHandle_t displayFrameQueue = NULL;
+DisplayStats displayStats = { 0, 0, 0, 0 };
+
+#if DISPLAY_COLOR_DEPTH == 4
+// Pixels in LCD byte order, indexed by the COLOR_* values
+#define LCD_ORDER(color) (uint16_t)(((color) >> 8) | ((color) << 8))
+const uint16_t displayPalette[16] = {
+    LCD_ORDER(BLACK), LCD_ORDER(WHITE), LCD_ORDER(RED), LCD_ORDER(GREEN), LCD_ORDER(YELLOW)
+};
+
+// Rows are padded to an even width, two pixels per byte with the left one
+// in the high nibble
+#define DISPLAY_ROW_BYTES ((SCREEN_WIDTH + 1) / 2)
+#define DISPLAY_LINE_BUFFER_SIZE (SCREEN_WIDTH * 8)
+
+uint16_t displayLineBuffer[DISPLAY_LINE_BUFFER_SIZE];
+
+// Expands the palette indices of a rectangle a few rows at a time into the
+// line buffer and pushes those
+void pushIndexed(const uint8_t *pixels, const DamageRect& rect) {
+    int16_t rowsPerChunk = DISPLAY_LINE_BUFFER_SIZE / rect.w;
+    for (int16_t y = rect.y; y < rect.y + rect.h; y += rowsPerChunk) {
+        int16_t rows = min(rowsPerChunk, (int16_t)(rect.y + rect.h - y));
+        uint16_t *dst = displayLineBuffer;
+        for (int16_t row = y; row < y + rows; ++row) {
+            const uint8_t *src = &pixels[row * DISPLAY_ROW_BYTES];
+            for (int16_t x = rect.x; x < rect.x + rect.w; ++x) {
+                uint8_t pair = src[x >> 1];
+                *dst++ = displayPalette[(x & 1) ? (pair & 0x0F) : (pair >> 4)];
+            }
+        }
+        M5.Lcd.pushImage(rect.x, y, rect.w, rows, displayLineBuffer);
+    }
+}
+#else
+void pushRgb565(const uint16_t *pixels, const DamageRect& rect) {
+    if (rect.w == SCREEN_WIDTH) {
+        // Full width rows are contiguous in the sprite
+        M5.Lcd.pushImage(0, rect.y, rect.w, rect.h, (uint16_t *)&pixels[rect.y * SCREEN_WIDTH]);
+        return;
+    }
+    for (int16_t y = rect.y; y < rect.y + rect.h; ++y) {
+        M5.Lcd.pushImage(rect.x, y, rect.w, 1, (uint16_t *)&pixels[y * SCREEN_WIDTH + rect.x]);
+    }
+}
+#endif
+
+bool Display::begin() {
+    displayFrameQueue = xQueueCreate(DISPLAY_BUFFER_COUNT, sizeof(uint8_t));
+
+    for (uint8_t i = 0; i < DISPLAY_BUFFER_COUNT; ++i) {
+        TFT_eSprite *sprite = new TFT_eSprite(&M5.Lcd);
+        sprite->setColorDepth(DISPLAY_COLOR_DEPTH);
+        if (sprite->createSprite(SCREEN_WIDTH, SCREEN_HEIGHT) == NULL) {
+            // Single buffered, acquire() then waits for every push
+            delete sprite;
+            break;
+        }
+
+        DisplayBuffer& buffer = displayBuffers[displayBufferCount++];
+        buffer.sprite = sprite;
+        buffer.damage = new DamageList(SCREEN_WIDTH, SCREEN_HEIGHT);
+        buffer.isFree = xSemaphoreCreateBinary();
+        xSemaphoreGive(buffer.isFree);
+    }
+
+    displayStats.bufferCount = displayBufferCount;
+    displayStats.bufferSize = (uint32_t)SCREEN_HEIGHT * ((SCREEN_WIDTH * DISPLAY_COLOR_DEPTH + 15) / 16) * 2;
+
+    if (displayBufferCount == 0) {
+        // Nothing to compose a frame in, say so straight on the LCD
+        M5.Lcd.fillScreen(RED);
+        M5.Lcd.setTextSize(2);
+        M5.Lcd.setTextColor(WHITE);
+        M5.Lcd.drawString("No display", 8, 10);
+        M5.Lcd.drawString("memory", 8, 30);
+        return false;
+    }
+    return true;
+}
+
+TFT_eSprite& Display::acquire() {
+    DisplayBuffer& buffer = displayBuffers[backBuffer];
+
+    uint32_t start = micros();
+    xSemaphoreTake(buffer.isFree, portMAX_DELAY);
+    displayStats.blockedTime += micros() - start;
+
+    buffer.damage->clear();
+    return *buffer.sprite;
+}
+
+DamageList& Display::getDamage() {
+    return *displayBuffers[backBuffer].damage;
+}
+
+void Display::submit() {
+    xQueueSend(displayFrameQueue, &backBuffer, portMAX_DELAY);
+    if (displayBufferCount == DISPLAY_BUFFER_COUNT) {
+        // Draw into the other buffer while this one is pushed. Single
+        // buffered, acquire() waits for the push of the only one.
+        backBuffer = (backBuffer + 1) % DISPLAY_BUFFER_COUNT;
+    }
+}
+
+void Display::waitIdle() {
+    for (uint8_t i = 0; i < displayBufferCount; ++i) {
+        xSemaphoreTake(displayBuffers[i].isFree, portMAX_DELAY);
+        xSemaphoreGive(displayBuffers[i].isFree);
+    }
+}
+
+uint8_t Display::waitFrame() {
+    uint8_t index;
+    xQueueReceive(displayFrameQueue, &index, portMAX_DELAY);
+    return index;
+}
+
+void Display::push(uint8_t index) {
+    PROFILE_SCOPE(PROFILE_PUSH_SPRITE);
+    DisplayBuffer& buffer = displayBuffers[index];
+    const DamageList& damage = *buffer.damage;
+
+    if (damage.getCount() > 0) {
+        // Pixels go out in LCD byte order, like pushSprite() does
+        const void *pixels = buffer.sprite->getPointer();
+        bool oldSwapBytes = M5.Lcd.getSwapBytes();
+        M5.Lcd.setSwapBytes(false);
+        M5.Lcd.startWrite();
+        for (uint8_t i = 0; i < damage.getCount(); ++i) {
+#if DISPLAY_COLOR_DEPTH == 4
+            pushIndexed((const uint8_t *)pixels, damage.get(i));
+#else
+            pushRgb565((const uint16_t *)pixels, damage.get(i));
+#endif
+        }
+        M5.Lcd.endWrite();
+        M5.Lcd.setSwapBytes(oldSwapBytes);
+    }
+
+    displayStats.framesPushed++;
+    xSemaphoreGive(buffer.isFree);
+}
+
+const DisplayStats& Display::getStats() {
+    return displayStats;
+}
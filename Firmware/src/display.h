@@ -0,0 +1,69 @@
+#pragma once
+#include <M5StickCPlus.h>
+#include "damagelist.h"
+
+#define SCREEN_WIDTH 135
+#define SCREEN_HEIGHT 240
+
+#define DISPLAY_BUFFER_COUNT 2
+
+// 4: 16 colour palette, 16 KB per buffer, expanded to RGB565 while pushing.
+// 16: RGB565, 64 KB per buffer, pushed as is.
+#ifndef DISPLAY_COLOR_DEPTH
+#define DISPLAY_COLOR_DEPTH 4
+#endif
+
+// Colours to draw into the display buffers with, palette indices or RGB565
+// depending on the colour depth
+#if DISPLAY_COLOR_DEPTH == 4
+#define COLOR_BLACK 0
+#define COLOR_WHITE 1
+#define COLOR_RED 2
+#define COLOR_GREEN 3
+#define COLOR_YELLOW 4
+#else
+#define COLOR_BLACK BLACK
+#define COLOR_WHITE WHITE
+#define COLOR_RED RED
+#define COLOR_GREEN GREEN
+#define COLOR_YELLOW YELLOW
+#endif
+
+typedef struct {
+    uint8_t bufferCount;        // 1 if the second sprite did not fit in the heap, 0 without a display
+    uint32_t bufferSize;        // bytes per buffer
+    uint32_t framesPushed;
+    uint64_t blockedTime;       // us the GUI task waited for a free buffer
+} DisplayStats;
+
+// Double buffered path to the LCD. The GUI task composes a frame in one
+// sprite while the display task pushes the previous one, so the SPI
+// transfer no longer stalls rendering and button polling. Only the regions
+// recorded in the frame's DamageList are pushed.
+class Display {
+public:
+    // Returns false if not even one buffer fits in the heap. The LCD then
+    // shows an error and nothing may be drawn or submitted.
+    static bool begin();
+
+    // Waits until the next buffer is no longer being pushed and returns it
+    // for drawing. Its damage list starts out empty.
+    static TFT_eSprite& acquire();
+
+    static DamageList& getDamage();
+
+    // Queues the acquired buffer for the display task
+    static void submit();
+
+    // Waits until every submitted frame is on the LCD
+    static void waitIdle();
+
+    // Display task side: blocks until a frame is submitted, returns its buffer
+    static uint8_t waitFrame();
+
+    // Display task side: sends the damaged regions of the buffer to the LCD
+    // and hands the buffer back to the GUI task
+    static void push(uint8_t index);
+
+    static const DisplayStats& getStats();
+};
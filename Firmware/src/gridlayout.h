@@ -0,0 +1,95 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+#define GRID_MIN_CELL_WIDTH 16      // two digits at text size 1 plus a margin
+#define GRID_MIN_CELL_HEIGHT 14
+#define GRID_MAX_COLUMNS 8
+
+// Cell geometry of the host tally grid for a camera count. The columns are
+// chosen so the cells come out as large as possible, if even the smallest
+// cells do not fit all cameras the grid is split into pages.
+class GridLayout {
+public:
+    GridLayout()
+        : count(0),
+        columns(1),
+        rows(1),
+        cellWidth(0),
+        cellHeight(0),
+        textSize(1),
+        pageSize(1),
+        pageCount(1),
+        areaWidth(0),
+        areaHeight(0) {
+    }
+
+    void update(uint8_t cameraCount, int16_t width, int16_t height) {
+        if (cameraCount == count && width == areaWidth && height == areaHeight) {
+            return;
+        }
+        count = cameraCount;
+        areaWidth = width;
+        areaHeight = height;
+
+        int16_t bestSize = 0;
+        for (uint8_t c = 1; c <= GRID_MAX_COLUMNS; ++c) {
+            uint8_t r = (max(count, (uint8_t)1) + c - 1) / c;
+            int16_t w = width / c;
+            int16_t h = height / r;
+            int16_t size = min(w, h);
+            if (w >= GRID_MIN_CELL_WIDTH && h >= GRID_MIN_CELL_HEIGHT && size > bestSize) {
+                bestSize = size;
+                columns = c;
+                rows = r;
+                cellWidth = w;
+                cellHeight = h;
+            }
+        }
+
+        if (bestSize == 0) {
+            columns = min((int16_t)GRID_MAX_COLUMNS, (int16_t)(width / GRID_MIN_CELL_WIDTH));
+            rows = height / GRID_MIN_CELL_HEIGHT;
+            cellWidth = width / columns;
+            cellHeight = height / rows;
+        }
+
+        pageSize = columns * rows;
+        pageCount = (max(count, (uint8_t)1) + pageSize - 1) / pageSize;
+
+        // Largest text the longest number fits into with a 2 pixel margin
+        uint8_t digits = count >= 10 ? 2 : 1;
+        textSize = 1;
+        while (textSize < 4 && digits * 6 * (textSize + 1) <= cellWidth - 4 && 8 * (textSize + 1) <= cellHeight - 4) {
+            textSize++;
+        }
+    }
+
+    // Camera index at the given position on a page, the cell is empty if
+    // it is not below the camera count
+    uint8_t getCamera(uint8_t page, uint8_t position) const {
+        return page * pageSize + position;
+    }
+
+    // Top left corner of a cell on its page, the cell covers cellWidth x
+    // cellHeight including its right and bottom border line
+    int16_t getCellX(uint8_t position) const {
+        return (position % columns) * cellWidth;
+    }
+
+    int16_t getCellY(uint8_t position) const {
+        return (position / columns) * cellHeight;
+    }
+
+    uint8_t count;
+    uint8_t columns;
+    uint8_t rows;
+    int16_t cellWidth;
+    int16_t cellHeight;
+    uint8_t textSize;
+    uint8_t pageSize;
+    uint8_t pageCount;
+
+private:
+    int16_t areaWidth;
+    int16_t areaHeight;
+};
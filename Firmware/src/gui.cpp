@@ -1,347 +1,826 @@
 #include <M5StickCPlus.h>
 #include <WiFi.h>
 #include "MenuItem.h"
-#include "buttonreader.h"
+#include "buttoninput.h"
+#include "spanimage.h"
+#include "spanimages.h"
+#include "numberfont.h"
+#include "gridlayout.h"
+
+// Set to 1 in build_flags for the Glyph bench menu entry
+#ifndef GLYPH_BENCHMARK
+#define GLYPH_BENCHMARK 0
+#endif
+
+#if GLYPH_BENCHMARK
+// The uncompressed source of spanimages.h, only linked in for the comparison
 #include "xbmimages.h"
+#endif
 #include "gui.h"
 #include "system.h"
+#include "tasks.h"
+#include "profiler.h"
+#include "display.h"
 
-TFT_eSprite sprite = TFT_eSprite(&M5.Lcd);
-ButtonReader btnA(&M5.BtnA);
+#define GRID_HEIGHT 222             // the error line stays clear below
+#define GRID_PAGE_TIME 3000         // ms each page is shown when the cameras need more than one
+
+#define MENU_NODE_ROWS 5
+#define MENU_SELECTION_ROWS 8
 
 #define STATE_BOOTING 0
 #define STATE_NORMAL 1
 #define STATE_MENU 2
 
 #define MONITOR_UPDATE_DELAY 30
-#define LOGIC_UPDATE_DELAY 50
 #define BOOTING_DELAY_DEFAULT 1500
 #define BTN_ENTER_DELAY 1500
 
 uint32_t bootingDelay = BOOTING_DELAY_DEFAULT;
 uint32_t lastMonitorUpdateMS = 0;
-uint32_t lastLogicUpdateMS = 0;
 uint32_t lastBtnReleasedMs = 0;
 uint32_t currentState = STATE_BOOTING;
 uint32_t lastStateMS = 0;
 
-MenuItem *rootMenu = NULL;
-MenuItem *currentMenu = NULL;
+#define MENU_DEPTH_MAX 4
+
+#define MENU_STATE_MODE 0
+#define MENU_STATE_AUDIO 1
+#define MENU_STATE_BRIGHTNESS 2
+#define MENU_STATE_COUNT 3
+
+const MenuItem *currentMenu = NULL;
+const MenuItem *menuPath[MENU_DEPTH_MAX];      // menus above the current one
+uint8_t menuPathRows[MENU_DEPTH_MAX];          // row each of them was left through
+uint8_t menuDepth = 0;
+uint8_t menuSelections[MENU_STATE_COUNT];
 int32_t currentMenuSelection = 0;
 int32_t currentMenuViewPos = 0;
 bool isModifyingSelection = false;
 bool isLongPressedBefore = false;
 
-const char *ModeOptions[] = { "Host", "Camera 1", "Camera 2", "Camera 3", "Camera 4",
-	"Camera 5", "Camera 6", "Camera 7", "Camera 8" };
-const char *AudioOptions[] = { "On", "Off" };
-const char *BrightnessOptions[] = { "1", "2", "3", "4", "5" };
+TallySnapshot snapshot;
+bool isDisplayReady = false;    // the tally keeps running without a screen
+
+// Everything the current screen depends on. A frame is only drawn and
+// pushed when this differs from the one of the last pushed frame.
+typedef struct {
+	uint32_t state;
+	uint8_t mode;
+	uint8_t currentStatus;
+	bool isTestMode;
+	uint8_t cameraCount;
+	uint8_t gridPage;
+	uint8_t cameraStatus[MAX_CAMERA_COUNT];
+	char errorMsg[32];
+	const MenuItem *menu;
+	int32_t menuSelection;
+	int32_t menuViewPos;
+	bool isModifyingSelection;
+	uint32_t menuRowHashes[MENU_NODE_ROWS];
+} DisplayKey;
+
+DisplayKey lastDisplayKey;
+bool hasDisplayKey = false;
+
+GridLayout gridLayout;
+uint8_t gridPage = 0;
+uint32_t lastGridPageMS = 0;
+RenderStats renderStats = { 0, 0, 0 };
+
+constexpr const char *ModeOptions[] = {
+	"Host", "Camera 1", "Camera 2", "Camera 3", "Camera 4", "Camera 5", "Camera 6", "Camera 7",
+	"Camera 8", "Camera 9", "Camera 10", "Camera 11", "Camera 12", "Camera 13", "Camera 14", "Camera 15",
+	"Camera 16", "Camera 17", "Camera 18", "Camera 19", "Camera 20", "Camera 21", "Camera 22", "Camera 23",
+	"Camera 24", "Camera 25", "Camera 26", "Camera 27", "Camera 28", "Camera 29", "Camera 30", "Camera 31",
+	"Camera 32", "Camera 33", "Camera 34", "Camera 35", "Camera 36", "Camera 37", "Camera 38", "Camera 39",
+	"Camera 40", "Camera 41", "Camera 42", "Camera 43", "Camera 44", "Camera 45", "Camera 46", "Camera 47",
+	"Camera 48", "Camera 49", "Camera 50", "Camera 51", "Camera 52", "Camera 53", "Camera 54", "Camera 55",
+	"Camera 56", "Camera 57", "Camera 58", "Camera 59", "Camera 60", "Camera 61", "Camera 62", "Camera 63",
+	"Camera 64",
+};
+static_assert(MENU_ARRAY_SIZE(ModeOptions) == MODE_CAMERA_MAX + 1, "one mode option per camera");
+constexpr const char *AudioOptions[] = { "On", "Off" };
+constexpr const char *BrightnessOptions[] = { "1", "2", "3", "4", "5" };
+static_assert(MENU_ARRAY_SIZE(BrightnessOptions) == BRIGHTNESS_LEVEL_COUNT, "one option per brightness level");
+
+char radioStatsDesc[48] = "";
+char loopStatsDesc[32] = "";
+char ledStatsDesc[32] = "";
+char ledFillDesc[32] = "";
+char ledLayoutDesc[32] = "";
+char linkStatsDescs[5][12] = { "", "", "", "", "" };
+char taskStatsDescs[TASK_COUNT][48] = {};
+char profileDescs[PROFILE_SECTION_COUNT][48] = {};
+char renderStatsDesc[48] = "";
+char pushStatsDesc[32] = "";
+char displayBenchDesc[48] = "Hold to run";
+char displayBufferDesc[32] = "";
+char addressDesc[18] = "";
+char settingsDesc[32] = "";
+char inputDesc[32] = "";
+#if GLYPH_BENCHMARK
+char glyphBenchDesc[32] = "Hold to run";
+#endif
+
+void updateStatsDescs() {
+	const TxStats& stats = snapshot.txStats;
+	snprintf(radioStatsDesc, sizeof(radioStatsDesc), "%ufps tta %lu/%luus",
+		stats.framesPerSecond, (unsigned long)stats.lastTimeToAir, (unsigned long)stats.maxTimeToAir);
+
+	const LoopStats& loopStats = snapshot.loopStats;
+	snprintf(loopStatsDesc, sizeof(loopStatsDesc), "avg %lu max %luus",
+		(unsigned long)(loopStats.loops ? loopStats.totalTime / loopStats.loops : 0), (unsigned long)loopStats.maxTime);
+
+	const LedStats& ledStats = snapshot.ledStats;
+	snprintf(ledStatsDesc, sizeof(ledStatsDesc), "%u of %u/s, %uus max",
+		ledStats.showsPerSecond, ledStats.updatesPerSecond, snapshot.ledEffectStats.maxRenderTime);
+	snprintf(ledFillDesc, sizeof(ledFillDesc), "%lu/%luus",
+		(unsigned long)ledStats.lastFillTime, (unsigned long)ledStats.maxFillTime);
+	snprintf(ledLayoutDesc, sizeof(ledLayoutDesc), "%u px, %u segments",
+		snapshot.ledLayout.count, snapshot.ledLayout.segmentCount);
+
+	if (snapshot.hasLink) {
+		const LinkStats& link = snapshot.latestLink;
+		const uint32_t values[] = { link.received, link.lost, link.duplicate, link.stale };
+		for (int32_t i = 0; i < 4; ++i) {
+			snprintf(linkStatsDescs[i], sizeof(linkStatsDescs[i]), "%lu", (unsigned long)values[i]);
+		}
+	}
+	snprintf(linkStatsDescs[4], sizeof(linkStatsDescs[4]), "%lu", (unsigned long)snapshot.radioFramesDropped);
 
-void GUI::begin() {
-    sprite.createSprite(135, 240);
-
-	rootMenu = new MenuItem("Menu");
-	{
-        auto modeMenu = new MenuItem("Mode", NULL);
-        modeMenu->setTypeToSelection(System::getMode(), ModeOptions, CAMERA_COUNT + 1);
-		modeMenu->setCallback([](MenuItem *item, bool isManually) -> void {
-            System::setMode(item->selection);
-		});
-		rootMenu->addChild(modeMenu);
-
-        auto audioMenu = new MenuItem("Audio", NULL);
-        audioMenu->setTypeToSelection(System::getIsAudioEnabled() ? 0 : 1, AudioOptions, 2);
-		audioMenu->setCallback([](MenuItem *item, bool isManually) -> void {
-            System::setIsAudioEnabled(item->selection == 0);
-		});
-		rootMenu->addChild(audioMenu);
-
-
-        auto brightnessMenu = new MenuItem("Brightness", NULL);
-        brightnessMenu->setTypeToSelection(System::getBrightness(), BrightnessOptions, 5);
-		brightnessMenu->setCallback([](MenuItem *item, bool isManually) -> void {
-            System::setBrightness(item->selection);
-		});
-		rootMenu->addChild(brightnessMenu);
-
-		auto deciveAddressMenu = new MenuItem("Address", NULL);
-        {
-            const auto macAddress = WiFi.macAddress();
-            auto size = macAddress.length() + 1;
-            char *addressStr = new char[size];
-            strcpy(addressStr, macAddress.c_str());
-            addressStr[size - 1] = '\0';
-            deciveAddressMenu->desc = addressStr;
-        }
-		rootMenu->addChild(deciveAddressMenu);
-
-		auto versionMenu = new MenuItem("Version", FIRMWARE_VERSION, eNode);
-		rootMenu->addChild(versionMenu);
+	for (uint8_t i = 0; i < TASK_COUNT; ++i) {
+		TaskStats taskStats;
+		Tasks::getStats(i, taskStats);
+		snprintf(taskStatsDescs[i], sizeof(taskStatsDescs[i]), "%u%% max %luus stack %lu",
+			taskStats.load, (unsigned long)taskStats.maxUpdateTime, (unsigned long)taskStats.stackHighWater);
+	}
+
+	for (uint8_t i = 0; i < PROFILE_SECTION_COUNT; ++i) {
+		ProfileResult result;
+		Profiler::getResult(i, result);
+		snprintf(profileDescs[i], sizeof(profileDescs[i]), "a%lu p%lu m%luus",
+			(unsigned long)result.avgTime, (unsigned long)result.p99Time, (unsigned long)result.maxTime);
+	}
+
+	const ButtonStats& buttonStats = ButtonInput::getStats();
+	snprintf(inputDesc, sizeof(inputDesc), "%lu/%luus latency",
+		(unsigned long)buttonStats.lastLatency, (unsigned long)buttonStats.maxLatency);
+
+	const SettingsStats& settingsStats = snapshot.settingsStats;
+	snprintf(settingsDesc, sizeof(settingsDesc), "%lu commits, %s",
+		(unsigned long)settingsStats.commits, settingsStats.isDirty ? "pending" : "saved");
+
+	snprintf(renderStatsDesc, sizeof(renderStatsDesc), "%lu drawn %lu skipped",
+		(unsigned long)renderStats.framesRendered, (unsigned long)renderStats.framesSkipped);
+	snprintf(pushStatsDesc, sizeof(pushStatsDesc), "%lu bytes/frame",
+		(unsigned long)(renderStats.framesRendered ? renderStats.bytesPushed / renderStats.framesRendered : 0));
+}
+
+uint32_t hashString(uint32_t hash, const char *str) {
+	// FNV-1a
+	while (*str != '\0') {
+		hash = (hash ^ (uint8_t)*str++) * 16777619UL;
+	}
+	return hash;
+}
+
+// Texts of the menu rows on screen, stats descriptions change while the menu is open
+void hashMenuRows(uint32_t *hashes) {
+	if (isModifyingSelection) {
+		return;
+	}
+	int16_t visibleCount = min(currentMenu->numChildren + 1, currentMenuViewPos + MENU_NODE_ROWS);
+	for (int16_t i = max(currentMenuViewPos, 1); i < visibleCount; ++i) {
+		const MenuItem *child = &currentMenu->children[i - 1];
+		uint32_t hash = 2166136261UL;
+		if (child->type == eNode && child->desc != NULL) {
+			hash = hashString(hash, child->desc);
+		} else if (child->type == eSelection) {
+			hash = hashString(hash, child->options[menuSelections[child->stateIndex]]);
+		}
+		hashes[i - currentMenuViewPos] = hash;
+	}
+}
+
+void makeDisplayKey(DisplayKey& key) {
+	// Zeroed as a whole so padding and unused fields compare equal
+	memset(&key, 0, sizeof(DisplayKey));
+	key.state = currentState;
+
+	if (currentState == STATE_NORMAL) {
+		key.mode = snapshot.mode;
+		key.currentStatus = snapshot.currentStatus;
+		key.isTestMode = snapshot.isTestMode;
+		if (snapshot.mode == MODE_HOST) {
+			key.cameraCount = snapshot.cameraCount;
+			key.gridPage = gridPage;
+			memcpy(key.cameraStatus, snapshot.cameraStatus, snapshot.cameraCount);
+		}
+		memcpy(key.errorMsg, snapshot.errorMsg, sizeof(key.errorMsg));
+	} else if (currentState == STATE_MENU) {
+		key.menu = currentMenu;
+		key.menuSelection = currentMenuSelection;
+		key.menuViewPos = currentMenuViewPos;
+		key.isModifyingSelection = isModifyingSelection;
+		hashMenuRows(key.menuRowHashes);
 	}
+}
+
+void addMenuRowDamage(DamageList& damage, int32_t row) {
+	int16_t lineHeight = (currentMenu->type == eSelection) ? 25 : 38;
+	damage.add(0, 36 + row * lineHeight, SCREEN_WIDTH, lineHeight);
+}
+
+// Regions that differ between the screens described by the last pushed
+// key and the new one
+void addDamage(DamageList& damage, const DisplayKey& key) {
+	const DisplayKey& last = lastDisplayKey;
+
+	if (!hasDisplayKey || key.state != last.state || key.state == STATE_BOOTING) {
+		damage.addAll();
+		return;
+	}
+
+	if (key.state == STATE_NORMAL) {
+		if (key.mode != last.mode || key.currentStatus != last.currentStatus
+			|| key.isTestMode != last.isTestMode || key.cameraCount != last.cameraCount
+			|| key.gridPage != last.gridPage) {
+			damage.addAll();
+			return;
+		}
+
+		// Host grid cells of the page on screen
+		for (uint8_t i = 0; i < gridLayout.pageSize; ++i) {
+			uint8_t camera = gridLayout.getCamera(key.gridPage, i);
+			if (camera < key.cameraCount && key.cameraStatus[camera] != last.cameraStatus[camera]) {
+				damage.add(gridLayout.getCellX(i), gridLayout.getCellY(i), gridLayout.cellWidth, gridLayout.cellHeight);
+			}
+		}
+
+		if (strcmp(key.errorMsg, last.errorMsg) != 0) {
+			damage.add(0, 225, SCREEN_WIDTH, 8);
+		}
+	} else {
+		if (key.menu != last.menu || key.menuViewPos != last.menuViewPos
+			|| key.isModifyingSelection != last.isModifyingSelection) {
+			damage.addAll();
+			return;
+		}
+
+		if (key.menuSelection != last.menuSelection) {
+			addMenuRowDamage(damage, last.menuSelection - key.menuViewPos);
+			addMenuRowDamage(damage, key.menuSelection - key.menuViewPos);
+		}
+
+		for (int32_t i = 0; i < MENU_NODE_ROWS; ++i) {
+			if (key.menuRowHashes[i] != last.menuRowHashes[i]) {
+				addMenuRowDamage(damage, i);
+			}
+		}
+	}
+}
+
+// Fixed workload for the display benchmark: a full screen host grid with
+// every cell changing from frame to frame
+void drawBenchmarkFrame(TFT_eSprite& sprite, uint8_t frame) {
+	char buf[4];
+	sprite.fillScreen(COLOR_BLACK);
+	sprite.setTextColor(COLOR_WHITE);
+	sprite.setTextSize(3);
+	for (int32_t i = 0; i < 20; ++i) {
+		int32_t x = (i % 4) * 34;
+		int32_t y = (i / 4) * 44;
+		sprite.fillRect(x, y, 34, 43, (i + frame) % 2 ? COLOR_RED : COLOR_GREEN);
+		snprintf(buf, sizeof(buf), "%d", (int)(i + 1) % 10);
+		sprite.drawString(buf, 10 + x, y + 10);
+	}
+}
+
+// Time the GUI task is blocked per frame, waiting for each push to finish
+// before drawing the next frame vs drawing while the previous one is pushed
+void runDisplayBenchmark() {
+	const uint8_t frameCount = 16;
+	uint32_t blocked[2];
+
+	for (uint8_t isPipelined = 0; isPipelined < 2; ++isPipelined) {
+		Display::waitIdle();
+		uint64_t startBlocked = Display::getStats().blockedTime;
+		uint32_t waitTime = 0;
+
+		for (uint8_t i = 0; i < frameCount; ++i) {
+			TFT_eSprite& sprite = Display::acquire();
+			Display::getDamage().addAll();
+			drawBenchmarkFrame(sprite, i);
+			Display::submit();
+
+			if (!isPipelined) {
+				uint32_t start = micros();
+				Display::waitIdle();
+				waitTime += micros() - start;
+			}
+		}
+
+		uint32_t start = micros();
+		Display::waitIdle();
+		waitTime += micros() - start;
+
+		blocked[isPipelined] = (Display::getStats().blockedTime - startBlocked + waitTime) / frameCount;
+	}
+
+	snprintf(displayBenchDesc, sizeof(displayBenchDesc), "sync %lu dbl %luus",
+		(unsigned long)blocked[0], (unsigned long)blocked[1]);
+
+	// The LCD shows the benchmark frames now
+	hasDisplayKey = false;
+}
+
+#if GLYPH_BENCHMARK
+// Draw time of all number images and the logo, bit by bit from the XBM
+// source vs from the run-span data
+void runGlyphBenchmark() {
+	TFT_eSprite& sprite = Display::acquire();
+	uint32_t start = micros();
+	for (uint8_t i = 0; i < NumberSpanImageCount; ++i) {
+		sprite.drawXBitmap(0, 0, NumberXBitmaps[i], NumberXBitmapWidth, NumberXBitmapHeight, COLOR_WHITE);
+	}
+	sprite.drawXBitmap(0, 0, LogoXBitmap, NumberXBitmapWidth, NumberXBitmapHeight, COLOR_WHITE);
+	uint32_t xbmTime = micros() - start;
+
+	start = micros();
+	for (uint8_t i = 0; i < NumberSpanImageCount; ++i) {
+		drawSpanImage(sprite, 0, 0, NumberSpanImages[i], SpanImageHeight, COLOR_WHITE);
+	}
+	drawSpanImage(sprite, 0, 0, LogoSpanImage, SpanImageHeight, COLOR_WHITE);
+	uint32_t spanTime = micros() - start;
+
+	// The damage list is empty, the display task pushes nothing
+	Display::submit();
+	hasDisplayKey = false;
+
+	snprintf(glyphBenchDesc, sizeof(glyphBenchDesc), "xbm %lu span %luus",
+		(unsigned long)xbmTime / (NumberSpanImageCount + 1), (unsigned long)spanTime / (NumberSpanImageCount + 1));
+}
+#endif
+
+void onModeSelected(uint8_t selection) {
+	System::postCommand(COMMAND_SET_MODE, selection);
+}
+
+void onAudioSelected(uint8_t selection) {
+	System::postCommand(COMMAND_SET_AUDIO, selection == 0);
+}
+
+void onBrightnessSelected(uint8_t selection) {
+	System::postCommand(COMMAND_SET_BRIGHTNESS, selection);
+}
+
+void onProfileReset(uint8_t) {
+	Profiler::reset();
+}
+
+void onDisplayBenchmark(uint8_t) {
+	runDisplayBenchmark();
+}
+
+#if GLYPH_BENCHMARK
+void onGlyphBenchmark(uint8_t selection) {
+	runGlyphBenchmark();
+}
+#endif
+
+constexpr MenuItem LedMenuItems[] = {
+	MENU_NODE("Output", ledStatsDesc, NULL),
+	MENU_NODE("Fill", ledFillDesc, NULL),
+	MENU_NODE("Layout", ledLayoutDesc, NULL),
+};
+
+constexpr MenuItem LinkMenuItems[] = {
+	MENU_NODE("Received", linkStatsDescs[0], NULL),
+	MENU_NODE("Lost", linkStatsDescs[1], NULL),
+	MENU_NODE("Duplicate", linkStatsDescs[2], NULL),
+	MENU_NODE("Stale", linkStatsDescs[3], NULL),
+	MENU_NODE("Overflow", linkStatsDescs[4], NULL),
+};
+
+constexpr MenuItem TaskMenuItems[] = {
+	MENU_NODE(TaskNames[TASK_TALLY], taskStatsDescs[TASK_TALLY], NULL),
+	MENU_NODE(TaskNames[TASK_GUI], taskStatsDescs[TASK_GUI], NULL),
+	MENU_NODE(TaskNames[TASK_DISPLAY], taskStatsDescs[TASK_DISPLAY], NULL),
+	MENU_NODE(TaskNames[TASK_LED], taskStatsDescs[TASK_LED], NULL),
+};
+static_assert(MENU_ARRAY_SIZE(TaskMenuItems) == TASK_COUNT, "one entry per task");
+
+constexpr MenuItem ProfileMenuItems[] = {
+	MENU_NODE(ProfileSectionNames[PROFILE_TALLY_LOOP], profileDescs[PROFILE_TALLY_LOOP], NULL),
+	MENU_NODE(ProfileSectionNames[PROFILE_GUI_LOOP], profileDescs[PROFILE_GUI_LOOP], NULL),
+	MENU_NODE(ProfileSectionNames[PROFILE_RADIO], profileDescs[PROFILE_RADIO], NULL),
+	MENU_NODE(ProfileSectionNames[PROFILE_COMMANDS], profileDescs[PROFILE_COMMANDS], NULL),
+	MENU_NODE(ProfileSectionNames[PROFILE_LED_SHOW], profileDescs[PROFILE_LED_SHOW], NULL),
+	MENU_NODE(ProfileSectionNames[PROFILE_PUSH_SPRITE], profileDescs[PROFILE_PUSH_SPRITE], NULL),
+	MENU_NODE("Reset", NULL, onProfileReset),
+};
+static_assert(MENU_ARRAY_SIZE(ProfileMenuItems) == PROFILE_SECTION_COUNT + 1, "one entry per profiled section");
+
+constexpr MenuItem RootMenuItems[] = {
+	MENU_SELECTION("Mode", ModeOptions, MENU_STATE_MODE, onModeSelected),
+	MENU_SELECTION("Audio", AudioOptions, MENU_STATE_AUDIO, onAudioSelected),
+	MENU_SELECTION("Brightness", BrightnessOptions, MENU_STATE_BRIGHTNESS, onBrightnessSelected),
+	MENU_NODE("Address", addressDesc, NULL),
+	MENU_NODE("Radio", radioStatsDesc, NULL),
+	MENU_NODE("Loop", loopStatsDesc, NULL),
+	MENU_PARENT("LEDs", LedMenuItems),
+	MENU_PARENT("Link", LinkMenuItems),
+	MENU_PARENT("Tasks", TaskMenuItems),
+	MENU_PARENT("Profile", ProfileMenuItems),
+	MENU_NODE("Render", renderStatsDesc, NULL),
+	MENU_NODE("LCD push", pushStatsDesc, NULL),
+	MENU_NODE("LCD buffer", displayBufferDesc, NULL),
+	MENU_NODE("LCD bench", displayBenchDesc, onDisplayBenchmark),
+#if GLYPH_BENCHMARK
+	MENU_NODE("Glyph bench", glyphBenchDesc, onGlyphBenchmark),
+#endif
+	MENU_NODE("Input", inputDesc, NULL),
+	MENU_NODE("Settings", settingsDesc, NULL),
+	MENU_NODE("Version", FIRMWARE_VERSION, NULL),
+};
+
+constexpr MenuItem RootMenu = MENU_PARENT("Menu", RootMenuItems);
+
+void GUI::begin() {
+    isDisplayReady = Display::begin();
+    ButtonInput::begin();
+
+	menuSelections[MENU_STATE_MODE] = System::getMode();
+	menuSelections[MENU_STATE_AUDIO] = System::getIsAudioEnabled() ? 0 : 1;
+	menuSelections[MENU_STATE_BRIGHTNESS] = System::getBrightness();
+
+	uint8_t mac[6];
+	WiFi.macAddress(mac);
+	snprintf(addressDesc, sizeof(addressDesc), "%02X:%02X:%02X:%02X:%02X:%02X",
+		mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+
+	const DisplayStats& displayStats = Display::getStats();
+	snprintf(displayBufferDesc, sizeof(displayBufferDesc), "%ux %lu bytes %ubpp",
+		displayStats.bufferCount, (unsigned long)displayStats.bufferSize, DISPLAY_COLOR_DEPTH);
 
 	lastStateMS = millis();
 }
 
-void GUI::update(uint32_t ms) {
+void render(TFT_eSprite& sprite) {
 	char buf[128];
 	int32_t x, y;
 
-	if (ms - lastMonitorUpdateMS >= MONITOR_UPDATE_DELAY) {
-        sprite.fillScreen(BLACK);
-
-		switch (currentState) {
-		case STATE_BOOTING:
-            sprite.drawXBitmap(0, 0, LogoXBitmap, NumberXBitmapWidth, NumberXBitmapHeight, WHITE);
-			break;
-
-		case STATE_NORMAL:
-			{
-                auto mode = System::getMode();
-                auto status = System::getCurrentCameraStatus();
-
-                if (System::isInTestMode()) {
-                    sprite.fillScreen(YELLOW);
-                } else {
-                    if (mode != MODE_HOST) {
-                        if (status == CAMERA_STATUS_PREVIEW) {
-                            sprite.fillScreen(GREEN);
-                        } else if (status == CAMERA_STATUS_PROGRAM) {
-                            sprite.fillScreen(RED);
-                        }
+	sprite.fillScreen(COLOR_BLACK);
+
+	switch (currentState) {
+	case STATE_BOOTING:
+        drawSpanImage(sprite, 0, 0, LogoSpanImage, SpanImageHeight, COLOR_WHITE);
+		break;
+
+	case STATE_NORMAL:
+		{
+            auto mode = snapshot.mode;
+            auto status = snapshot.currentStatus;
+
+            if (snapshot.isTestMode) {
+                sprite.fillScreen(COLOR_YELLOW);
+            } else {
+                if (mode != MODE_HOST) {
+                    if (status == CAMERA_STATUS_PREVIEW) {
+                        sprite.fillScreen(COLOR_GREEN);
+                    } else if (status == CAMERA_STATUS_PROGRAM) {
+                        sprite.fillScreen(COLOR_RED);
                     }
                 }
-
-                sprite.drawXBitmap(0, 0, NumberXBitmaps[mode], NumberXBitmapWidth, NumberXBitmapHeight, WHITE);
-                sprite.setTextSize(1);
-                sprite.setTextColor(WHITE);
-
-                if (mode == MODE_HOST) {
-                    char numberStr[2] = { '1', '\0' };
-                    auto status = System::getCameraStatus();
-                    sprite.setTextSize(3);
-                    for (int32_t i = 0; i < CAMERA_COUNT; ++i) {
-						x = (i % 4) * 34;
-						y = (i / 4) * 44;
-                        if (status[i] == CAMERA_STATUS_PREVIEW) {
-                            sprite.fillRect(x, y, 34, 43, GREEN);
-                        } else if (status[i] == CAMERA_STATUS_PROGRAM) {
-                            sprite.fillRect(x, y, 34, 43, RED);
-                        } else {
-                            sprite.fillRect(x, y, 34, 43, BLACK);
-                        }
-
-						numberStr[0] = '1' + i;
-                        sprite.drawString(numberStr, 10 + x, y + 10);
+            }
+
+            if (mode <= MODE_CAMERA_8) {
+                drawSpanImage(sprite, 0, 0, NumberSpanImages[mode], SpanImageHeight, COLOR_WHITE);
+            } else {
+                // No artwork beyond camera 8, the error line stays clear below
+                NumberFont::draw(sprite, mode, 8, 8, SCREEN_WIDTH - 16, 210, COLOR_WHITE);
+            }
+            sprite.setTextSize(1);
+            sprite.setTextColor(COLOR_WHITE);
+
+            if (mode == MODE_HOST) {
+                auto status = snapshot.cameraStatus;
+                const GridLayout& grid = gridLayout;
+                sprite.setTextDatum(MC_DATUM);
+                sprite.setTextSize(grid.textSize);
+                for (uint8_t i = 0; i < grid.pageSize; ++i) {
+                    uint8_t camera = grid.getCamera(gridPage, i);
+                    if (camera >= snapshot.cameraCount) {
+                        break;
                     }
-                    
-                    for (int32_t i = 0; i < CAMERA_COUNT; ++i) {
-                        sprite.drawLine(((i % 4) + 1) * 34, (i / 4) * 44, ((i % 4) + 1) * 34, (i / 4) * 44 + 43, WHITE);
+
+                    // The last column and row of a cell are its border
+                    x = grid.getCellX(i);
+                    y = grid.getCellY(i);
+                    if (status[camera] == CAMERA_STATUS_PREVIEW) {
+                        sprite.fillRect(x, y, grid.cellWidth - 1, grid.cellHeight - 1, COLOR_GREEN);
+                    } else if (status[camera] == CAMERA_STATUS_PROGRAM) {
+                        sprite.fillRect(x, y, grid.cellWidth - 1, grid.cellHeight - 1, COLOR_RED);
+                    } else {
+                        sprite.fillRect(x, y, grid.cellWidth - 1, grid.cellHeight - 1, COLOR_BLACK);
                     }
+                    sprite.drawFastVLine(x + grid.cellWidth - 1, y, grid.cellHeight, COLOR_WHITE);
+                    sprite.drawFastHLine(x, y + grid.cellHeight - 1, grid.cellWidth, COLOR_WHITE);
 
-                    sprite.drawLine(0, 43, 135, 43, WHITE);
-					if (CAMERA_COUNT > 4) {
-                    	sprite.drawLine(0, 86, 135, 86, WHITE);
-					}
+                    snprintf(buf, sizeof(buf), "%d", camera + 1);
+                    sprite.drawString(buf, x + grid.cellWidth / 2, y + grid.cellHeight / 2);
                 }
-
-                const String& errorMsg = System::getErrorMsg();
-                if (errorMsg.length() > 0) {
-					sprite.setTextSize(1);
-                	sprite.setTextColor(WHITE);
-                    sprite.drawString(errorMsg, 8, 225);
+                sprite.setTextDatum(TL_DATUM);
+
+                if (grid.pageCount > 1) {
+                    snprintf(buf, sizeof(buf), "%d/%d", gridPage + 1, grid.pageCount);
+                    sprite.setTextSize(1);
+                    sprite.setTextDatum(TR_DATUM);
+                    sprite.drawString(buf, SCREEN_WIDTH - 2, 225);
+                    sprite.setTextDatum(TL_DATUM);
                 }
+            }
 
+            const char *errorMsg = snapshot.errorMsg;
+            if (errorMsg[0] != '\0') {
+				sprite.setTextSize(1);
+            	sprite.setTextColor(COLOR_WHITE);
+                sprite.drawString(errorMsg, 8, 225);
+            }
+
+		}
+		break;
+
+	case STATE_MENU:
+		// Heading & Frame
+        sprite.setTextSize(2);
+        sprite.setTextColor(COLOR_WHITE);
+        sprite.drawString(currentMenu->name, 8, 10);
+		sprite.drawLine(0, 30, 135, 30, COLOR_WHITE);
+
+		int16_t itemCount = isModifyingSelection ? currentMenu->numOptions : currentMenu->numChildren + 1;
+		int16_t visibleCount = min(itemCount, currentMenuViewPos + (currentMenu->type == eSelection ? MENU_SELECTION_ROWS : MENU_NODE_ROWS));
+		for (int32_t i = currentMenuViewPos, j = 0; i < visibleCount; ++i, ++j) {
+            int16_t lineHeight = (currentMenu->type == eSelection) ? 25 : 38;
+
+			if (currentMenuSelection == i) {
+                sprite.fillRect(0, 36 + j*lineHeight, 135, lineHeight - 1, COLOR_RED);
 			}
-			break;
 
-		case STATE_MENU:
-			// Heading & Frame
             sprite.setTextSize(2);
-            sprite.setTextColor(WHITE);
-            sprite.drawString(currentMenu->name, 8, 10);
-			sprite.drawLine(0, 30, 135, 30, WHITE);
-
-			int16_t itemCount = isModifyingSelection ? currentMenu->numOptions : currentMenu->numChildren + 1;
-			int16_t visibleCount = min(itemCount, currentMenuViewPos + (currentMenu->type == eSelection ? 8 : 5));
-			for (uint32_t i = currentMenuViewPos, j = 0; i < visibleCount; ++i, ++j) {
-                int16_t lineHeight = (currentMenu->type == eSelection) ? 25 : 38;
-
-				if (currentMenuSelection == i) {
-                    sprite.fillRect(0, 36 + j*lineHeight, 135, lineHeight - 1, RED);
-				}
-
-                sprite.setTextSize(2);
-				if (currentMenu->type == eSelection) {
-					sprite.drawString(currentMenu->options[i], 8, 40 + j*lineHeight);
-				} else {
-					MenuItem *child = currentMenu->children[i-1];
-					sprite.drawString(i == 0 ? "<Go back" : child->name, 8, 40 + j*lineHeight);
-
-					if (i != 0) {
-						const char *str = NULL;
-
-						if ((child->type == eNode && child->desc != NULL)
-							|| (child->type == eSelection)) {
-							const char *previewStr = NULL;
-							if (child->type == eNode) {
-								previewStr = child->desc;
-                            } else {
-								previewStr = child->options[child->selection];
-                            }
+			if (currentMenu->type == eSelection) {
+				sprite.drawString(currentMenu->options[i], 8, 40 + j*lineHeight);
+			} else {
+				const MenuItem *child = i == 0 ? NULL : &currentMenu->children[i-1];
+				sprite.drawString(i == 0 ? "<Go back" : child->name, 8, 40 + j*lineHeight);
+
+				if (i != 0) {
+					const char *str = NULL;
+
+					if ((child->type == eNode && child->desc != NULL)
+						|| (child->type == eSelection)) {
+						const char *previewStr = NULL;
+						if (child->type == eNode) {
+							previewStr = child->desc;
+                        } else {
+							previewStr = child->options[menuSelections[child->stateIndex]];
+                        }
 
-							auto descLen = strlen(previewStr);
-							if (descLen > 20) {
-								int16_t k = 0;
-								for (k = 0; k < 20; ++k) {
-									buf[k] = previewStr[k];
-                                }
-								buf[k++] = '.';
-								buf[k++] = '.';
-								buf[k] = '\0';
-								str = buf;
-							} else {
-								str = previewStr;
+						auto descLen = strlen(previewStr);
+						if (descLen > 20) {
+							int16_t k = 0;
+							for (k = 0; k < 20; ++k) {
+								buf[k] = previewStr[k];
                             }
-						}
+							buf[k++] = '.';
+							buf[k++] = '.';
+							buf[k] = '\0';
+							str = buf;
+						} else {
+							str = previewStr;
+                        }
+					}
 
-						if (str != NULL) {
-                            sprite.setTextSize(1);
-							sprite.drawString(str, 8, 60 + j*lineHeight);
-						}
+					if (str != NULL) {
+                        sprite.setTextSize(1);
+						sprite.drawString(str, 8, 60 + j*lineHeight);
 					}
 				}
 			}
-			break;
 		}
+		break;
+	}
 
-        sprite.pushSprite(0, 0);
-		lastMonitorUpdateMS = ms;
+}
+
+// The row the menu is left through is where the cursor returns to
+void enterMenu(const MenuItem *item) {
+	menuPath[menuDepth] = currentMenu;
+	menuPathRows[menuDepth] = currentMenuSelection;
+	menuDepth++;
+	currentMenu = item;
+}
+
+// Wraps around at both ends and scrolls the view along
+void moveMenuSelection(int32_t delta) {
+	int16_t itemCount = isModifyingSelection ?
+		currentMenu->numOptions : currentMenu->numChildren + 1;
 
+	if (itemCount > 1) {
+		currentMenuSelection += delta;
+		while (currentMenuSelection < 0) {
+			currentMenuSelection += itemCount;
+		}
+		while (currentMenuSelection >= itemCount) {
+			currentMenuSelection -= itemCount;
+		}
+
+		int16_t viewDist = currentMenuSelection - currentMenuViewPos;
+		int16_t threshold = (currentMenu->type == eSelection ? 7 : 4);
+		if (viewDist > threshold) {
+			currentMenuViewPos += viewDist - threshold;
+		} else if (viewDist < 0) {
+			currentMenuViewPos = currentMenuSelection;
+		}
 	}
+}
 
-	if (ms - lastLogicUpdateMS >= LOGIC_UPDATE_DELAY) {
-        auto buttonState = btnA.get();
-        if (ms - lastBtnReleasedMs > 4000 && buttonState == ButtonReader::ButtonState::Held) {
-            System::powerOff();
-        } else if (buttonState == ButtonReader::ButtonState::Open) {
-            lastBtnReleasedMs = ms;
-        }
-
-		switch (currentState) {
-		case STATE_BOOTING:
-			if (ms - lastStateMS >= bootingDelay) {
+// A: click moves down, hold enters or confirms. B: click moves up, double
+// click jumps to the top row. Returns true if the screen has to change.
+bool handleInput(uint32_t ms) {
+	ButtonInput::update();
+
+	uint32_t lastState = currentState;
+	const MenuItem *lastMenu = currentMenu;
+	int32_t lastSelection = currentMenuSelection;
+
+    auto buttonState = ButtonInput::get(BUTTON_A).get();
+    auto buttonBState = ButtonInput::get(BUTTON_B).get();
+    if (ms - lastBtnReleasedMs > 4000 && buttonState == ButtonReader::ButtonState::Held) {
+        System::postCommand(COMMAND_POWER_OFF);
+    } else if (buttonState == ButtonReader::ButtonState::Open) {
+        lastBtnReleasedMs = ms;
+    }
+
+	switch (currentState) {
+	case STATE_BOOTING:
+		if (ms - lastStateMS >= bootingDelay) {
+			lastStateMS = ms;
+			currentState = STATE_NORMAL;
+		}
+		break;
+
+	case STATE_NORMAL:
+		{
+			if (!isLongPressedBefore && buttonState == ButtonReader::ButtonState::Held) {
+                isLongPressedBefore = true;
+				currentState = STATE_MENU;
+				currentMenu = &RootMenu;
+				menuDepth = 0;
+				currentMenuSelection = 0;
+				currentMenuViewPos = 0;
 				lastStateMS = ms;
-				currentState = STATE_NORMAL;
-			}
-			break;
-
-		case STATE_NORMAL:
-			{
-				if (!isLongPressedBefore && buttonState == ButtonReader::ButtonState::Held) {
-                    isLongPressedBefore = true;
-					currentState = STATE_MENU;
-					currentMenu = rootMenu;
-					currentMenuSelection = 0;
-					currentMenuViewPos = 0;
-					lastStateMS = ms;
-				} else if (buttonState != ButtonReader::ButtonState::Held) {
-                    isLongPressedBefore = false;
-                }
-
-                if (System::getMode() == MODE_HOST && buttonState == ButtonReader::ButtonState::Clicked) {
-                    System::sendTestMessage();
-                }
-			}
-			break;
+			} else if (buttonState != ButtonReader::ButtonState::Held) {
+                isLongPressedBefore = false;
+            }
 
-		case STATE_MENU:
-			{
-				MenuItem *selectedItem = NULL;
-				if (currentMenuSelection != 0 && !isModifyingSelection) {
-					selectedItem = currentMenu->children[currentMenuSelection - 1];
-                }
+            if (snapshot.mode == MODE_HOST && buttonState == ButtonReader::ButtonState::Clicked) {
+                System::postCommand(COMMAND_SEND_TEST, 0xff);
+            }
+		}
+		break;
+
+	case STATE_MENU:
+		{
+			const MenuItem *selectedItem = NULL;
+			if (currentMenuSelection != 0 && !isModifyingSelection) {
+				selectedItem = &currentMenu->children[currentMenuSelection - 1];
+            }
+
+			if (!isLongPressedBefore && buttonState == ButtonReader::ButtonState::Held) {
+                isLongPressedBefore = true;
+				if (isModifyingSelection) {
+					isModifyingSelection = false;
+					menuSelections[currentMenu->stateIndex] = currentMenuSelection;
+					if (currentMenu->action != NULL) {
+						currentMenu->action(currentMenuSelection);
+                    }
 
-				if (!isLongPressedBefore && buttonState == ButtonReader::ButtonState::Held) {
-                    isLongPressedBefore = true;
-					if (isModifyingSelection) {
-						isModifyingSelection = false;
-						currentMenu->selection = currentMenuSelection;
-						if (currentMenu->callback) {
-							currentMenu->callback(currentMenu, true);
+					currentMenuViewPos = 0;
+					menuDepth--;
+					currentMenuSelection = menuPathRows[menuDepth];
+					currentMenu = menuPath[menuDepth];
+				} else if (currentMenuSelection == 0) {
+					if (menuDepth == 0) {
+						lastStateMS = ms;
+						currentState = STATE_NORMAL;
+					} else {
+						menuDepth--;
+						currentMenu = menuPath[menuDepth];
+						currentMenuSelection = 0;
+						currentMenuViewPos = 0;
+					}
+				} else if (currentMenuSelection > 0) {
+					if (selectedItem->type == eSelection) {
+						isModifyingSelection = true;
+						enterMenu(selectedItem);
+						currentMenuSelection = menuSelections[selectedItem->stateIndex];
+						currentMenuViewPos = 0;
+					} else if (selectedItem->type == eNode) {
+						if (selectedItem->action != NULL) {
+							selectedItem->action(0);
                         }
 
-						currentMenuViewPos = 0;
-						currentMenuSelection = currentMenu->parent->getChildIndex(currentMenu)+1;
-						currentMenu = currentMenu->parent;
-					} else if (currentMenuSelection == 0) {
-						if (currentMenu == rootMenu) {
-							lastStateMS = ms;
-							currentState = STATE_NORMAL;
-						} else {
-							currentMenu = currentMenu->parent;
+						if (selectedItem->numChildren) {
+							enterMenu(selectedItem);
 							currentMenuSelection = 0;
 							currentMenuViewPos = 0;
 						}
-					} else if (currentMenuSelection > 0) {
-						if (selectedItem->type == eSelection) {
-							if (selectedItem->isModifiable) {
-								isModifyingSelection = true;
-								currentMenu = selectedItem;
-								currentMenuSelection = selectedItem->selection;
-								currentMenuViewPos = 0;
-							}
-						} else if (selectedItem->type == eNode) {
-							if (selectedItem->callback != NULL) {
-								selectedItem->callback(selectedItem, true);
-                            }
-
-							if (selectedItem->numChildren) {
-								currentMenu = selectedItem;
-								currentMenuSelection = 0;
-								currentMenuViewPos = 0;
-							}
-						}
-						
-						int16_t viewDist = currentMenuSelection - currentMenuViewPos;
-						int16_t threshold = (currentMenu->type == eSelection ? 7 : 4);
-						if (viewDist > threshold) {
-							currentMenuViewPos += viewDist - threshold;
-						} else if (viewDist < 0) {
-							currentMenuViewPos = currentMenuSelection;
-						}
 					}
-				} else {
-                    if (buttonState != ButtonReader::ButtonState::Held) {
-                        isLongPressedBefore = false;
-                    }
-                    if (buttonState == ButtonReader::ButtonState::Clicked) {
-						int16_t itemCount = isModifyingSelection ?
-							currentMenu->numOptions : currentMenu->numChildren + 1;
-
-						if (itemCount > 1) {
-							currentMenuSelection += 1;
-							while (currentMenuSelection < 0) {
-								currentMenuSelection += itemCount;
-							}
-							while (currentMenuSelection >= itemCount) {
-								currentMenuSelection -= itemCount;
-							}
-
-							int16_t viewDist = currentMenuSelection - currentMenuViewPos;
-							int16_t threshold = (currentMenu->type == eSelection ? 7 : 4);
-							if (viewDist > threshold) {
-								currentMenuViewPos += viewDist - threshold;
-							} else if (viewDist < 0) {
-								currentMenuViewPos = currentMenuSelection;
-							}
-						}
-                    }
+					
+					int16_t viewDist = currentMenuSelection - currentMenuViewPos;
+					int16_t threshold = (currentMenu->type == eSelection ? 7 : 4);
+					if (viewDist > threshold) {
+						currentMenuViewPos += viewDist - threshold;
+					} else if (viewDist < 0) {
+						currentMenuViewPos = currentMenuSelection;
+					}
+				}
+			} else {
+                if (buttonState != ButtonReader::ButtonState::Held) {
+                    isLongPressedBefore = false;
                 }
-			}
-			break;
+                if (buttonState == ButtonReader::ButtonState::Clicked) {
+					moveMenuSelection(1);
+                } else if (buttonBState == ButtonReader::ButtonState::Clicked) {
+					moveMenuSelection(-1);
+                } else if (buttonBState == ButtonReader::ButtonState::DoubleClicked) {
+					moveMenuSelection(-currentMenuSelection);
+                }
+            }
 		}
+		break;
+	}
+
+	return currentState != lastState || currentMenu != lastMenu || currentMenuSelection != lastSelection;
+}
 
-		lastLogicUpdateMS = ms;
-        btnA.update();
+void GUI::update(uint32_t ms) {
+	PROFILE_SCOPE(PROFILE_GUI_LOOP);
+
+	if (!isDisplayReady) {
+		return;
+	}
+
+	System::getSnapshot(snapshot);
+
+	// Input is handled on every update, a change is drawn right away
+	bool hasInputChange = handleInput(ms);
+
+	if (hasInputChange || ms - lastMonitorUpdateMS >= MONITOR_UPDATE_DELAY) {
+		if (currentState == STATE_MENU) {
+			updateStatsDescs();
+		}
+
+		gridLayout.update(snapshot.cameraCount, SCREEN_WIDTH, GRID_HEIGHT);
+		if (gridPage >= gridLayout.pageCount) {
+			gridPage = 0;
+		} else if (gridLayout.pageCount > 1 && ms - lastGridPageMS >= GRID_PAGE_TIME) {
+			gridPage = (gridPage + 1) % gridLayout.pageCount;
+			lastGridPageMS = ms;
+		}
+
+		DisplayKey key;
+		makeDisplayKey(key);
+		if (hasDisplayKey && memcmp(&key, &lastDisplayKey, sizeof(DisplayKey)) == 0) {
+			renderStats.framesSkipped++;
+		} else {
+			TFT_eSprite& sprite = Display::acquire();
+			DamageList& damage = Display::getDamage();
+			addDamage(damage, key);
+			lastDisplayKey = key;
+			hasDisplayKey = true;
+			renderStats.framesRendered++;
+			renderStats.bytesPushed += damage.getPixelCount() * 2;
+
+			// The whole sprite is redrawn, it is cheap compared to the LCD transfer
+			render(sprite);
+			Display::submit();
+		}
+		lastMonitorUpdateMS = ms;
 	}
-}
\ No newline at end of file
+
+}
+
+const RenderStats& GUI::getRenderStats() {
+	return renderStats;
+}
+
+const char *GUI::getMenuName() {
+	return currentState == STATE_MENU ? currentMenu->name : NULL;
+}
+
+int32_t GUI::getMenuSelection() {
+	return currentMenuSelection;
+}
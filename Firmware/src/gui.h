@@ -1,9 +1,23 @@
 #pragma once
 #include <M5StickCPlus.h>
 
+typedef struct {
+    uint32_t framesRendered;
+    uint32_t framesSkipped;     // display state unchanged, nothing drawn or pushed
+    uint64_t bytesPushed;       // sent to the LCD, only the damaged regions of each frame
+} RenderStats;
+
 class GUI {
 public:
     static void begin();
 
     static void update(uint32_t ms);
+
+    static const RenderStats& getRenderStats();
+
+    // Name of the menu or option list on screen, NULL outside the menu
+    static const char *getMenuName();
+
+    // Highlighted row, 0 is "<Go back" in a menu, the option in an option list
+    static int32_t getMenuSelection();
 };
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+#include <M5StickCPlus.h>
+#include <FastLED.h>
+#include "ledoutput.h"
+
+#define LED_FRAME_INTERVAL 20000    // us between rendered frames, 50 Hz
+#define LED_FADE_TIME 120           // ms to fade from one colour to the next
+#define LED_PULSE_PERIOD 800        // ms of one test mode pulse
+#define LED_PULSE_MIN 96            // lowest pulse level, out of 255
+#define LED_BLINK_PERIOD 1000       // ms of one link loss blink
+#define LED_BLINK_ON_TIME 150
+#define LED_LINK_LOSS_TIME 1000     // ms without a status frame before a receiver blinks
+
+#define LED_EFFECT_SOLID 0          // fades to the colour and stays there
+#define LED_EFFECT_PULSE 1          // breathes between LED_PULSE_MIN and full
+#define LED_EFFECT_BLINK 2          // short flash once per period
+
+typedef struct {
+    uint32_t frames;
+    uint32_t lastRenderTime;    // us
+    uint32_t maxRenderTime;     // us
+} LedEffectStats;
+
+// Perceptual level to PWM duty, gamma 2.2
+const uint8_t LedGammaTable[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6,
+    6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 11, 11, 11, 12,
+    12, 13, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19,
+    20, 20, 21, 22, 22, 23, 23, 24, 25, 25, 26, 26, 27, 28, 28, 29,
+    30, 30, 31, 32, 33, 33, 34, 35, 35, 36, 37, 38, 39, 39, 40, 41,
+    42, 43, 43, 44, 45, 46, 47, 48, 49, 49, 50, 51, 52, 53, 54, 55,
+    56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71,
+    73, 74, 75, 76, 77, 78, 79, 81, 82, 83, 84, 85, 87, 88, 89, 90,
+    91, 93, 94, 95, 97, 98, 99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+typedef struct {
+    uint8_t effect;
+    CRGB target;
+    CRGB from;
+    CRGB current;
+    uint32_t changeTime;
+} LedEffectState;
+
+// Renders one colour per LED role for the current effects. Colours are
+// interpolated in perceptual space with 8 bit fixed point fractions, then
+// gamma corrected and scaled to the brightness in a single lookup per
+// channel. The cost does not depend on the strip length, the LED task
+// fills the segments. All times are in milliseconds.
+class LedEffects {
+public:
+    LedEffects()
+        : brightness(0),
+        stats({0, 0, 0}) {
+        for (uint8_t i = 0; i < LED_ROLE_COUNT; ++i) {
+            states[i] = { LED_EFFECT_SOLID, CRGB::Black, CRGB::Black, CRGB::Black, 0 };
+        }
+        setBrightness(255);
+    }
+
+    // Rebuilds the output table, only when the brightness changed
+    void setBrightness(uint8_t scale) {
+        if (scale == brightness) {
+            return;
+        }
+        brightness = scale;
+        for (uint16_t i = 0; i < 256; ++i) {
+            outputTable[i] = LedGammaTable[i] * (scale + 1) >> 8;
+        }
+    }
+
+    // A new effect or colour restarts the effect, fading from what is shown now
+    void set(uint8_t role, uint8_t effect, const CRGB& color, uint32_t ms) {
+        LedEffectState& state = states[role];
+        if (effect == state.effect && color == state.target) {
+            return;
+        }
+        state.from = state.current;
+        state.effect = effect;
+        state.target = color;
+        state.changeTime = ms;
+    }
+
+    void render(uint32_t ms, LedFrame& frame) {
+        uint32_t start = micros();
+
+        frame.roleColors[LED_ROLE_OFF] = CRGB::Black;
+        for (uint8_t i = LED_ROLE_OFF + 1; i < LED_ROLE_COUNT; ++i) {
+            CRGB color = renderState(states[i], ms);
+            frame.roleColors[i] = CRGB(outputTable[color.r], outputTable[color.g], outputTable[color.b]);
+        }
+
+        stats.frames++;
+        stats.lastRenderTime = micros() - start;
+        if (stats.lastRenderTime > stats.maxRenderTime) {
+            stats.maxRenderTime = stats.lastRenderTime;
+        }
+    }
+
+    const LedEffectStats& getStats() const {
+        return stats;
+    }
+
+private:
+    static CRGB renderState(LedEffectState& state, uint32_t ms) {
+        uint32_t elapsed = ms - state.changeTime;
+        uint8_t effect = state.effect;
+        const CRGB& target = state.target;
+
+        CRGB color = target;
+        if (effect == LED_EFFECT_PULSE) {
+            // Triangle wave, the gamma table makes it look like breathing
+            uint32_t phase = elapsed % LED_PULSE_PERIOD;
+            uint32_t half = LED_PULSE_PERIOD / 2;
+            uint8_t level = phase < half ? phase * 255 / half : (LED_PULSE_PERIOD - phase) * 255 / half;
+            color = scale(target, LED_PULSE_MIN + ((255 - LED_PULSE_MIN) * level >> 8));
+        } else if (effect == LED_EFFECT_BLINK) {
+            color = elapsed % LED_BLINK_PERIOD < LED_BLINK_ON_TIME ? target : CRGB(CRGB::Black);
+        }
+
+        // Every change fades in, including into the first pulse or blink. The
+        // first frame already takes one step, so a change shows in the frame
+        // rendered for it.
+        uint32_t fadeElapsed = elapsed + LED_FRAME_INTERVAL / 1000;
+        if (fadeElapsed < LED_FADE_TIME) {
+            color = blend(state.from, color, fadeElapsed * 256 / LED_FADE_TIME);
+        }
+        state.current = color;
+        return color;
+    }
+
+    static uint8_t lerp(uint8_t a, uint8_t b, uint16_t fraction) {
+        return a + (((int16_t)b - a) * (int16_t)fraction >> 8);
+    }
+
+    // fraction is out of 256
+    static CRGB blend(const CRGB& a, const CRGB& b, uint16_t fraction) {
+        return CRGB(lerp(a.r, b.r, fraction), lerp(a.g, b.g, fraction), lerp(a.b, b.b, fraction));
+    }
+
+    static CRGB scale(const CRGB& color, uint8_t level) {
+        return CRGB(color.r * (level + 1) >> 8, color.g * (level + 1) >> 8, color.b * (level + 1) >> 8);
+    }
+
+    LedEffectState states[LED_ROLE_COUNT];
+    uint8_t brightness;
+    uint8_t outputTable[256];
+    LedEffectStats stats;
+};
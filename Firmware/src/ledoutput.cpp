@@ -0,0 +1,110 @@
+#include "ledoutput.h"
+
+CRGB leds[EXTERNAL_LED_MAX];
+CLEDController *ledController = NULL;
+uint8_t ledLength = 0;              // pixels the strip was last driven with
+
+QueueHandle_t ledFrameQueue = NULL;
+LedFrame committedFrame;
+bool hasCommittedFrame = false;
+
+LedStats ledStats = { 0, 0, 0, 0, 0, 0 };
+uint32_t ledWindowStartTime = 0;
+uint32_t ledWindowUpdates = 0;
+uint32_t ledWindowShows = 0;
+
+// Doubles the filled run with every copy, a long segment takes a handful
+// of memcpy calls instead of a store per pixel
+void fillPixels(CRGB *dst, uint8_t length, const CRGB& color) {
+    if (length == 0) {
+        return;
+    }
+    dst[0] = color;
+    uint8_t filled = 1;
+    while (filled < length) {
+        uint8_t n = min(filled, length - filled);
+        memcpy(&dst[filled], dst, n * sizeof(CRGB));
+        filled += n;
+    }
+}
+
+void LedOutput::begin() {
+    ledFrameQueue = xQueueCreate(1, sizeof(LedFrame));
+    // The length is set per frame, the buffer covers the longest strip
+    ledController = &FastLED.addLeds<NEOPIXEL, EXTERNAL_LED_PIN>(leds, 0);
+    FastLED.setBrightness(255);
+}
+
+bool LedOutput::isValidLayout(const LedLayout& layout) {
+    if (layout.count > EXTERNAL_LED_MAX || layout.segmentCount > LED_SEGMENT_MAX) {
+        return false;
+    }
+    for (uint8_t i = 0; i < layout.segmentCount; ++i) {
+        const LedSegment& segment = layout.segments[i];
+        if (segment.start + segment.length > layout.count || segment.role >= LED_ROLE_COUNT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LedOutput::getDefaultLayout(LedLayout& layout, uint8_t count) {
+    memset(&layout, 0, sizeof(layout));
+    layout.count = count;
+    layout.segmentCount = 1;
+    layout.segments[0] = { 0, count, LED_ROLE_OPERATOR };
+}
+
+void LedOutput::update(const LedFrame& frame, uint32_t us) {
+    ledStats.updates++;
+    ledWindowUpdates++;
+
+    if (!hasCommittedFrame || memcmp(&frame, &committedFrame, sizeof(LedFrame)) != 0) {
+        committedFrame = frame;
+        hasCommittedFrame = true;
+
+        // A frame the LED task has not picked up yet is outdated, replace it
+        xQueueOverwrite(ledFrameQueue, &frame);
+        ledStats.shows++;
+        ledWindowShows++;
+    }
+
+    uint32_t elapsed = us - ledWindowStartTime;
+    if (elapsed >= 1000000UL) {
+        ledStats.updatesPerSecond = (uint64_t)ledWindowUpdates * 1000000UL / elapsed;
+        ledStats.showsPerSecond = (uint64_t)ledWindowShows * 1000000UL / elapsed;
+        ledWindowUpdates = 0;
+        ledWindowShows = 0;
+        ledWindowStartTime = us;
+    }
+}
+
+void LedOutput::waitFrame(LedFrame& frame) {
+    xQueueReceive(ledFrameQueue, &frame, portMAX_DELAY);
+}
+
+void LedOutput::show(const LedFrame& frame) {
+    uint32_t start = micros();
+    const LedLayout& layout = frame.layout;
+
+    // After the strip got shorter, the pixels past the end are cleared once
+    uint8_t length = max(layout.count, ledLength);
+    fillPixels(leds, length, CRGB::Black);
+    for (uint8_t i = 0; i < layout.segmentCount; ++i) {
+        const LedSegment& segment = layout.segments[i];
+        fillPixels(&leds[segment.start], segment.length, frame.roleColors[segment.role]);
+    }
+
+    ledStats.lastFillTime = micros() - start;
+    if (ledStats.lastFillTime > ledStats.maxFillTime) {
+        ledStats.maxFillTime = ledStats.lastFillTime;
+    }
+
+    ledController->setLeds(leds, length);
+    FastLED.show();
+    ledLength = layout.count;
+}
+
+const LedStats& LedOutput::getStats() {
+    return ledStats;
+}
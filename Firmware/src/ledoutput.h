@@ -0,0 +1,72 @@
+#pragma once
+#include <M5StickCPlus.h>
+#include <FastLED.h>
+
+#define EXTERNAL_LED_PIN 32
+#define EXTERNAL_LED_MAX 150        // pixels the buffer is sized for
+#define EXTERNAL_LED_DEFAULT_NUM 4
+#define LED_SEGMENT_MAX 8
+
+// What a segment of the strip shows
+#define LED_ROLE_OFF 0
+#define LED_ROLE_OPERATOR 1         // preview, program, test and link state, faces the operator
+#define LED_ROLE_TALENT 2           // program only, faces the talent
+#define LED_ROLE_COUNT 3
+
+// All fields are bytes so frames compare without padding
+typedef struct {
+    uint8_t start;
+    uint8_t length;
+    uint8_t role;
+} LedSegment;
+
+// Pixels not covered by a segment stay off, a later segment wins where
+// segments overlap
+typedef struct {
+    uint8_t count;
+    uint8_t segmentCount;
+    LedSegment segments[LED_SEGMENT_MAX];
+} LedLayout;
+
+// Final colours per role, gamma and brightness are already applied. The
+// LED task expands them to pixels, so a frame stays small however long
+// the strip is.
+typedef struct {
+    LedLayout layout;
+    CRGB roleColors[LED_ROLE_COUNT];
+} LedFrame;
+
+typedef struct {
+    uint32_t updates;           // frames handed to update()
+    uint32_t shows;             // frames that differed and went out to the strip
+    uint16_t updatesPerSecond;  // measured over the last full second
+    uint16_t showsPerSecond;
+    uint32_t lastFillTime;      // us to expand the last frame to pixels
+    uint32_t maxFillTime;
+} LedStats;
+
+// Output stage of the external LED strip. update() compares a frame with
+// the last one sent and only passes changed frames on to the LED task,
+// which owns FastLED and does the RMT transmit. The tally task never
+// waits for the strip.
+class LedOutput {
+public:
+    static void begin();
+
+    // Whole layout with every segment inside the strip
+    static bool isValidLayout(const LedLayout& layout);
+
+    // A single segment of count pixels
+    static void getDefaultLayout(LedLayout& layout, uint8_t count = EXTERNAL_LED_DEFAULT_NUM);
+
+    // Tally task side
+    static void update(const LedFrame& frame, uint32_t us);
+
+    // LED task side: waits for the next changed frame
+    static void waitFrame(LedFrame& frame);
+
+    // LED task side: sends a frame to the strip
+    static void show(const LedFrame& frame);
+
+    static const LedStats& getStats();
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+#define LINK_MAX_COUNT 4        // transmitters tracked at the same time
+#define LINK_RESYNC_TIME 3000   // ms of silence after which an older sequence is accepted again
+
+typedef struct {
+    uint8_t address[6];
+    uint16_t lastSequence;
+    uint32_t lastReceivedTime;
+    uint32_t received;      // unique frames accepted
+    uint32_t lost;          // frames missing from the sequence
+    uint32_t duplicate;     // repeats of the last accepted frame (burst copies)
+    uint32_t stale;         // frames older than the last accepted one, dropped
+} LinkStats;
+
+// Per transmitter sequence tracking on the receiver side. accept() tells
+// whether a sequenced frame is new and should be applied.
+class LinkTable {
+public:
+    LinkTable() : count(0) {
+    }
+
+    bool accept(const uint8_t *address, uint16_t sequence, uint32_t ms) {
+        LinkStats *link = find(address, ms);
+        int16_t diff = (int16_t)(sequence - link->lastSequence);
+
+        if (link->received == 0 || (diff < 0 && ms - link->lastReceivedTime > LINK_RESYNC_TIME)) {
+            // First frame or the transmitter restarted, follow its sequence
+        } else if (diff == 0) {
+            link->duplicate++;
+            return false;
+        } else if (diff < 0) {
+            link->stale++;
+            return false;
+        } else {
+            link->lost += diff - 1;
+        }
+
+        link->lastSequence = sequence;
+        link->lastReceivedTime = ms;
+        link->received++;
+        return true;
+    }
+
+    uint8_t getCount() const {
+        return count;
+    }
+
+    const LinkStats& get(uint8_t index) const {
+        return links[index];
+    }
+
+    // The link heard from most recently, NULL if nothing was received yet
+    const LinkStats *getLatest() const {
+        const LinkStats *latest = NULL;
+        for (uint8_t i = 0; i < count; ++i) {
+            if (latest == NULL || (int32_t)(links[i].lastReceivedTime - latest->lastReceivedTime) > 0) {
+                latest = &links[i];
+            }
+        }
+        return latest;
+    }
+
+private:
+    LinkStats *find(const uint8_t *address, uint32_t ms) {
+        LinkStats *oldest = &links[0];
+        for (uint8_t i = 0; i < count; ++i) {
+            if (memcmp(links[i].address, address, 6) == 0) {
+                return &links[i];
+            }
+            if (ms - links[i].lastReceivedTime > ms - oldest->lastReceivedTime) {
+                oldest = &links[i];
+            }
+        }
+
+        LinkStats *link = count < LINK_MAX_COUNT ? &links[count++] : oldest;
+        memset(link, 0, sizeof(LinkStats));
+        memcpy(link->address, address, 6);
+        return link;
+    }
+
+    LinkStats links[LINK_MAX_COUNT];
+    uint8_t count;
+};
@@ -1,16 +1,15 @@
 #include <M5StickCPlus.h>
 #include "system.h"
 #include "gui.h"
+#include "tasks.h"
 
 void setup() {
     System::begin();
     GUI::begin();
+    Tasks::begin();
 }
 
 void loop() {
-    uint32_t ms = millis();
-
-    System::update(ms);
-    GUI::update(ms);
-    delay(1);
-}
\ No newline at end of file
+    // Everything runs in the tasks started by Tasks::begin()
+    vTaskDelete(NULL);
+}
@@ -0,0 +1,164 @@
+#include "numberfont.h"
+#include "spanimage.h"
+
+#define DIGIT_ASPECT 18             // height per 10 units of width
+#define DIGIT_GAP_DIVISOR 5         // gap between digits as part of the digit width
+#define DIGIT_MAX_SPANS 2           // a row of a block digit never has more runs
+
+// Segment bits: a top, b upper right, c lower right, d bottom, e lower left,
+// f upper left, g middle
+const uint8_t DigitSegments[10] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+};
+
+typedef struct {
+    int16_t width;
+    int16_t height;
+    uint8_t *digits[10];
+    uint32_t lastUsed;
+} DigitCache;
+
+DigitCache digitCaches[NUMBER_FONT_CACHE_SIZES] = {};
+uint32_t digitCacheClock = 0;
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+} SegmentRect;
+
+uint8_t segmentRects(uint8_t segments, int16_t w, int16_t h, SegmentRect *rects) {
+    int16_t t = max(w / 5, 2);
+    int16_t mid = (h - t) / 2;
+    const SegmentRect all[7] = {
+        { 0, 0, w, t },                     // a
+        { (int16_t)(w - t), 0, t, (int16_t)(mid + t) },         // b
+        { (int16_t)(w - t), mid, t, (int16_t)(h - mid) },       // c
+        { 0, (int16_t)(h - t), w, t },      // d
+        { 0, mid, t, (int16_t)(h - mid) },  // e
+        { 0, 0, t, (int16_t)(mid + t) },    // f
+        { 0, mid, w, t },                   // g
+    };
+
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < 7; ++i) {
+        if (segments & (1 << i)) {
+            rects[count++] = all[i];
+        }
+    }
+    return count;
+}
+
+// Covered runs of one row, merged and sorted, returns the run count
+uint8_t rowSpans(const SegmentRect *rects, uint8_t count, int16_t y, int16_t w, uint8_t *spans) {
+    uint8_t spanCount = 0;
+    int16_t start = -1;
+    for (int16_t x = 0; x <= w; ++x) {
+        bool isSet = false;
+        for (uint8_t i = 0; i < count && x < w; ++i) {
+            const SegmentRect& r = rects[i];
+            if (y >= r.y && y < r.y + r.h && x >= r.x && x < r.x + r.w) {
+                isSet = true;
+                break;
+            }
+        }
+        if (isSet && start < 0) {
+            start = x;
+        } else if (!isSet && start >= 0) {
+            spans[spanCount * 2] = start;
+            spans[spanCount * 2 + 1] = x - start;
+            spanCount++;
+            start = -1;
+        }
+    }
+    return spanCount;
+}
+
+// Same format as tools/xbm2spans.py writes
+uint8_t *rasterizeDigit(uint8_t digit, int16_t w, int16_t h) {
+    SegmentRect rects[7];
+    uint8_t count = segmentRects(DigitSegments[digit], w, h, rects);
+
+    // Worst case every row differs and has the most runs
+    uint8_t *data = new uint8_t[h * (1 + DIGIT_MAX_SPANS * 2)];
+    uint8_t *dst = data;
+    uint8_t prev[DIGIT_MAX_SPANS * 2];
+    uint8_t prevCount = 0xFF;
+    uint8_t repeat = 0;
+
+    for (int16_t y = 0; y < h; ++y) {
+        uint8_t spans[DIGIT_MAX_SPANS * 2];
+        uint8_t spanCount = rowSpans(rects, count, y, w, spans);
+
+        if (spanCount == prevCount && memcmp(spans, prev, spanCount * 2) == 0 && repeat < 0x7F) {
+            repeat++;
+            continue;
+        }
+        if (repeat > 0) {
+            *dst++ = 0x80 | repeat;
+            repeat = 0;
+        }
+        *dst++ = spanCount;
+        memcpy(dst, spans, spanCount * 2);
+        dst += spanCount * 2;
+        memcpy(prev, spans, spanCount * 2);
+        prevCount = spanCount;
+    }
+    if (repeat > 0) {
+        *dst++ = 0x80 | repeat;
+    }
+    return data;
+}
+
+// The cache for a digit size, the least recently used one is rebuilt on a miss
+DigitCache& findCache(int16_t w, int16_t h) {
+    DigitCache *oldest = &digitCaches[0];
+    for (uint8_t i = 0; i < NUMBER_FONT_CACHE_SIZES; ++i) {
+        DigitCache& cache = digitCaches[i];
+        if (cache.width == w && cache.height == h) {
+            cache.lastUsed = ++digitCacheClock;
+            return cache;
+        }
+        if (cache.lastUsed < oldest->lastUsed) {
+            oldest = &cache;
+        }
+    }
+
+    for (uint8_t i = 0; i < 10; ++i) {
+        delete [] oldest->digits[i];
+        oldest->digits[i] = NULL;
+    }
+    oldest->width = w;
+    oldest->height = h;
+    oldest->lastUsed = ++digitCacheClock;
+    return *oldest;
+}
+
+void NumberFont::draw(TFT_eSprite& sprite, uint16_t number, int32_t x, int32_t y, int16_t w, int16_t h, uint16_t color) {
+    char digits[6];
+    uint8_t digitCount = snprintf(digits, sizeof(digits), "%u", number);
+
+    // Widest digits whose row, gaps included, fits into w and whose height fits into h
+    int16_t digitWidth = w * DIGIT_GAP_DIVISOR / (digitCount * DIGIT_GAP_DIVISOR + digitCount - 1);
+    digitWidth = min(digitWidth, (int16_t)(h * 10 / DIGIT_ASPECT));
+    digitWidth = min(digitWidth, (int16_t)255);     // span bytes
+    int16_t digitHeight = digitWidth * DIGIT_ASPECT / 10;
+    int16_t gap = digitWidth / DIGIT_GAP_DIVISOR;
+    if (digitWidth < 4) {
+        return;
+    }
+
+    DigitCache& cache = findCache(digitWidth, digitHeight);
+
+    int16_t totalWidth = digitCount * digitWidth + (digitCount - 1) * gap;
+    int32_t left = x + (w - totalWidth) / 2;
+    int32_t top = y + (h - digitHeight) / 2;
+    for (uint8_t i = 0; i < digitCount; ++i) {
+        uint8_t digit = digits[i] - '0';
+        if (cache.digits[digit] == NULL) {
+            cache.digits[digit] = rasterizeDigit(digit, digitWidth, digitHeight);
+        }
+        drawSpanImage(sprite, left + i * (digitWidth + gap), top, cache.digits[digit], digitHeight, color);
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+#define NUMBER_FONT_CACHE_SIZES 3   // digit sizes kept rasterised at the same time
+
+// Scalable block digits built from seven segments. A digit is rasterised
+// into the run-span format of drawSpanImage() the first time it is drawn
+// at a size, later draws of the same digit and size are only span fills.
+class NumberFont {
+public:
+    // Draws number as large as fits into the box, centered
+    static void draw(TFT_eSprite& sprite, uint16_t number, int32_t x, int32_t y, int16_t w, int16_t h, uint16_t color);
+};
@@ -0,0 +1,78 @@
+#include <atomic>
+#include "profiler.h"
+
+typedef struct {
+    uint32_t count;
+    uint64_t totalCycles;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint32_t buckets[PROFILE_BUCKET_COUNT];
+} ProfileSection;
+
+ProfileSection profileSections[PROFILE_SECTION_COUNT] = {};
+std::atomic<uint32_t> profileResetPending(0);
+
+// Values below 4 get a bucket each, above that 4 buckets per power of 2
+uint8_t bucketIndex(uint32_t cycles) {
+    if (cycles < 4) {
+        return cycles;
+    }
+    uint8_t msb = 31 - __builtin_clz(cycles);
+    return (msb - 1) * 4 + ((cycles >> (msb - 2)) & 3);
+}
+
+uint32_t bucketUpperBound(uint8_t index) {
+    if (index < 4) {
+        return index;
+    }
+    uint8_t shift = index / 4 - 1;
+    return (((uint32_t)(4 + index % 4) << shift) - 1) + (1UL << shift);
+}
+
+void Profiler::record(uint8_t section, uint32_t cycles) {
+    ProfileSection& s = profileSections[section];
+
+    uint32_t bit = 1UL << section;
+    if (profileResetPending.load(std::memory_order_relaxed) & bit) {
+        memset(&s, 0, sizeof(ProfileSection));
+        profileResetPending.fetch_and(~bit);
+    }
+
+    if (s.count == 0 || cycles < s.minCycles) {
+        s.minCycles = cycles;
+    }
+    if (cycles > s.maxCycles) {
+        s.maxCycles = cycles;
+    }
+    s.totalCycles += cycles;
+    s.buckets[bucketIndex(cycles)]++;
+    s.count++;
+}
+
+void Profiler::getResult(uint8_t section, ProfileResult& result) {
+    const ProfileSection& s = profileSections[section];
+    uint32_t cyclesPerUs = ESP.getCpuFreqMHz();
+
+    result.count = s.count;
+    result.minTime = s.minCycles / cyclesPerUs;
+    result.avgTime = s.count ? s.totalCycles / s.count / cyclesPerUs : 0;
+    result.maxTime = s.maxCycles / cyclesPerUs;
+
+    result.p99Time = 0;
+    uint32_t remaining = s.count - s.count * 99ULL / 100;
+    for (int16_t i = PROFILE_BUCKET_COUNT - 1; i >= 0 && remaining > 0; --i) {
+        if (s.buckets[i] >= remaining) {
+            result.p99Time = min(bucketUpperBound(i), s.maxCycles) / cyclesPerUs;
+            break;
+        }
+        remaining -= s.buckets[i];
+    }
+}
+
+const char *Profiler::getName(uint8_t section) {
+    return ProfileSectionNames[section];
+}
+
+void Profiler::reset() {
+    profileResetPending = (1UL << PROFILE_SECTION_COUNT) - 1;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+// Set to 0 in build_flags to compile every PROFILE_SCOPE away
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#define PROFILE_TALLY_LOOP 0     // System::update, one tally task iteration
+#define PROFILE_GUI_LOOP 1       // GUI::update, one GUI task iteration
+#define PROFILE_RADIO 2          // processRadioFrame
+#define PROFILE_COMMANDS 3       // processCommands
+#define PROFILE_LED_SHOW 4       // LED frame update in System::update
+#define PROFILE_PUSH_SPRITE 5    // Display::push, one frame to the LCD
+#define PROFILE_SECTION_COUNT 6
+
+// constexpr so the menu tables can use them
+constexpr const char *ProfileSectionNames[PROFILE_SECTION_COUNT] = {
+    "Tally loop", "GUI loop", "Radio", "Commands", "LED show", "Push sprite"
+};
+
+// 4 buckets per power of 2, enough for the full 32 bit cycle range
+#define PROFILE_BUCKET_COUNT 128
+
+typedef struct {
+    uint32_t count;
+    uint32_t minTime;   // us
+    uint32_t avgTime;   // us
+    uint32_t maxTime;   // us
+    uint32_t p99Time;   // us, upper bound of the bucket holding the 99th percentile
+} ProfileResult;
+
+// Cycle counter based timing of code sections. Each section must only be
+// recorded from one task, the cycle counter is per core and the tasks are
+// pinned. Results can be read from any task, they are diagnostics and may
+// be off by the sample being recorded at that moment.
+class Profiler {
+public:
+    static void record(uint8_t section, uint32_t cycles);
+
+    static void getResult(uint8_t section, ProfileResult& result);
+
+    static const char *getName(uint8_t section);
+
+    // Clears all sections, applied by each section on its next sample
+    static void reset();
+};
+
+class ProfileScope {
+public:
+    ProfileScope(uint8_t section) : section(section), start(ESP.getCycleCount()) {
+    }
+
+    ~ProfileScope() {
+        Profiler::record(section, ESP.getCycleCount() - start);
+    }
+
+private:
+    uint8_t section;
+    uint32_t start;
+};
+
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(section) ProfileScope profileScope##section(section)
+#else
+#define PROFILE_SCOPE(section)
+#endif
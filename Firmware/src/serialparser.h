@@ -0,0 +1,287 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+#define SERIAL_FRAME_MAX_LEN 128
+#define SERIAL_TX_QUEUE_SIZE 512    // must be a power of 2
+
+#define SERIAL_ENCODING_HEX 0     // one hex encoded frame per '\n' terminated line
+#define SERIAL_ENCODING_COBS 1    // COBS encoded binary frame followed by 0x00
+
+// Incremental parser for the host link. Bytes are fed one at a time as they
+// arrive, it never waits for the rest of a frame. Hex lines and COBS frames
+// are decoded side by side, so the host can switch between them at any
+// frame boundary and a restarted host speaking hex is always understood.
+// Once a frame holds a byte no hex line can contain, it is a COBS frame
+// and a 0x0A in it is data, not the end of a line.
+// Malformed or oversized frames are dropped up to the next delimiter.
+class SerialParser {
+public:
+    SerialParser()
+        : hexLength(0),
+        isHighNibble(true),
+        isHexDiscarding(false),
+        cobsLength(0),
+        cobsRemaining(0),
+        isCobsZeroPending(false),
+        isCobsDiscarding(false),
+        frame(NULL),
+        frameLength(0),
+        encoding(SERIAL_ENCODING_HEX),
+        errorCount(0) {
+    }
+
+    // Returns true when c completed a frame, read it with getFrame() before
+    // feeding the next byte
+    bool feed(uint8_t c) {
+        if ((c != '\n' || !isCobsInProgress()) && feedHex(c)) {
+            // A hex line is a frame boundary for the binary side as well
+            resetCobs();
+            frame = hexFrame;
+            frameLength = hexLength;
+            encoding = SERIAL_ENCODING_HEX;
+            hexLength = 0;
+            return true;
+        }
+
+        if (feedCobs(c)) {
+            frame = cobsFrame;
+            frameLength = cobsLength;
+            encoding = SERIAL_ENCODING_COBS;
+            cobsLength = 0;
+            return true;
+        }
+
+        return false;
+    }
+
+    const uint8_t *getFrame() const {
+        return frame;
+    }
+
+    size_t getLength() const {
+        return frameLength;
+    }
+
+    // Encoding of the last completed frame, replies should use the same
+    uint8_t getEncoding() const {
+        return encoding;
+    }
+
+    uint32_t getErrorCount() const {
+        return errorCount;
+    }
+
+private:
+    // An intact COBS frame that is already known not to be a hex line
+    bool isCobsInProgress() const {
+        return isHexDiscarding && !isCobsDiscarding && (cobsLength > 0 || cobsRemaining > 0);
+    }
+
+    bool feedHex(uint8_t c) {
+        if (c == '\n') {
+            bool isComplete = !isHexDiscarding && isHighNibble && hexLength > 0;
+            if (!isComplete) {
+                // Lines with other characters are most likely binary frames
+                if (!isHexDiscarding) {
+                    errorCount++;
+                }
+                hexLength = 0;
+            }
+            isHighNibble = true;
+            isHexDiscarding = false;
+            return isComplete;
+        }
+
+        if (c == 0) {
+            // COBS delimiter, whatever came before was not a hex line
+            hexLength = 0;
+            isHighNibble = true;
+            isHexDiscarding = false;
+            return false;
+        }
+
+        if (isHexDiscarding || c == '\r') {
+            return false;
+        }
+
+        int8_t value = hexValue(c);
+        if (value < 0 || (isHighNibble && hexLength >= SERIAL_FRAME_MAX_LEN)) {
+            isHexDiscarding = true;
+            return false;
+        }
+
+        if (isHighNibble) {
+            hexFrame[hexLength] = value << 4;
+        } else {
+            hexFrame[hexLength++] |= value;
+        }
+        isHighNibble = !isHighNibble;
+        return false;
+    }
+
+    bool feedCobs(uint8_t c) {
+        if (c == 0) {
+            bool isComplete = !isCobsDiscarding && cobsRemaining == 0 && cobsLength > 0;
+            if (!isComplete) {
+                errorCount++;
+            }
+            cobsRemaining = 0;
+            isCobsZeroPending = false;
+            isCobsDiscarding = false;
+            if (!isComplete) {
+                cobsLength = 0;
+            }
+            return isComplete;
+        }
+
+        if (isCobsDiscarding) {
+            return false;
+        }
+
+        if (cobsRemaining == 0) {
+            // Code byte: the zero it stands for is only written once more data follows
+            if (isCobsZeroPending) {
+                appendCobs(0);
+            }
+            cobsRemaining = c - 1;
+            isCobsZeroPending = c != 0xFF;
+        } else {
+            appendCobs(c);
+            cobsRemaining--;
+        }
+        return false;
+    }
+
+    void appendCobs(uint8_t c) {
+        if (cobsLength >= SERIAL_FRAME_MAX_LEN) {
+            isCobsDiscarding = true;
+            return;
+        }
+        cobsFrame[cobsLength++] = c;
+    }
+
+    void resetCobs() {
+        cobsLength = 0;
+        cobsRemaining = 0;
+        isCobsZeroPending = false;
+        isCobsDiscarding = false;
+    }
+
+    static int8_t hexValue(uint8_t c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        } else if (c >= 'A' && c <= 'F') {
+            return 10 + (c - 'A');
+        } else if (c >= 'a' && c <= 'f') {
+            return 10 + (c - 'a');
+        }
+        return -1;
+    }
+
+    uint8_t hexFrame[SERIAL_FRAME_MAX_LEN];
+    size_t hexLength;
+    bool isHighNibble;
+    bool isHexDiscarding;
+
+    uint8_t cobsFrame[SERIAL_FRAME_MAX_LEN];
+    size_t cobsLength;
+    uint8_t cobsRemaining;
+    bool isCobsZeroPending;
+    bool isCobsDiscarding;
+
+    const uint8_t *frame;
+    size_t frameLength;
+    uint8_t encoding;
+    uint32_t errorCount;
+};
+
+// Outgoing bytes for the host link. Responses are queued here and written
+// out by flush() only as far as the UART TX FIFO has room, so loop() never
+// waits on the serial port.
+class SerialTxQueue {
+public:
+    SerialTxQueue() : head(0), tail(0), overflowCount(0) {
+    }
+
+    // Queues a frame as a hex line, all or nothing
+    bool writeHexLine(const uint8_t *data, size_t len) {
+        const char hex_str[] = "0123456789abcdef";
+
+        if (SERIAL_TX_QUEUE_SIZE - (head - tail) < len * 2 + 1) {
+            overflowCount++;
+            return false;
+        }
+
+        for (size_t i = 0; i < len; i++) {
+            put(hex_str[(data[i] >> 4) & 0x0F]);
+            put(hex_str[(data[i]     ) & 0x0F]);
+        }
+        put('\n');
+        return true;
+    }
+
+    // Queues a frame COBS encoded and terminated by 0x00, all or nothing
+    bool writeCobsFrame(const uint8_t *data, size_t len) {
+        // One code byte per 254 data bytes at worst, plus the delimiter
+        if (SERIAL_TX_QUEUE_SIZE - (head - tail) < len + len / 254 + 2) {
+            overflowCount++;
+            return false;
+        }
+
+        uint32_t codePos = head;
+        uint8_t code = 1;
+        put(0);
+        for (size_t i = 0; i < len; i++) {
+            if (data[i] != 0) {
+                put(data[i]);
+                code++;
+            }
+            if (data[i] == 0 || code == 0xFF) {
+                buffer[codePos & (SERIAL_TX_QUEUE_SIZE - 1)] = code;
+                codePos = head;
+                code = 1;
+                put(0);
+            }
+        }
+        buffer[codePos & (SERIAL_TX_QUEUE_SIZE - 1)] = code;
+        put(0);
+        return true;
+    }
+
+    bool writeFrame(const uint8_t *data, size_t len, uint8_t encoding) {
+        if (encoding == SERIAL_ENCODING_COBS) {
+            return writeCobsFrame(data, len);
+        }
+        return writeHexLine(data, len);
+    }
+
+    void flush(HardwareSerial& serial) {
+        int room = serial.availableForWrite();
+        while (room > 0 && tail != head) {
+            size_t start = tail & (SERIAL_TX_QUEUE_SIZE - 1);
+            size_t len = min((size_t)(head - tail), (size_t)(SERIAL_TX_QUEUE_SIZE - start));
+            len = min(len, (size_t)room);
+
+            size_t written = serial.write(&buffer[start], len);
+            if (written == 0) {
+                break;
+            }
+            tail += written;
+            room -= written;
+        }
+    }
+
+    uint32_t getOverflowCount() const {
+        return overflowCount;
+    }
+
+private:
+    void put(uint8_t c) {
+        buffer[head++ & (SERIAL_TX_QUEUE_SIZE - 1)] = c;
+    }
+
+    uint8_t buffer[SERIAL_TX_QUEUE_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t overflowCount;
+};
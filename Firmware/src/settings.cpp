@@ -0,0 +1,133 @@
+#include <Preferences.h>
+#include "settings.h"
+#include "system.h"
+
+#define PREF_LIB "pref_lib"
+#define PREF_SETTINGS_NAME "p_settings"
+
+// Single keys written before the settings blob, migrated once
+#define PREF_MODE_NAME "p_mode"
+#define PREF_AUDIO_NAME "p_audio"
+#define PREF_BRIGHTNESS_NAME "p_brignes"
+#define PREF_LED_LAYOUT_NAME "p_led_lay"
+
+Preferences preferences;
+Settings currentSettings;
+SettingsStats settingsStats = { 0, 0, false };
+uint32_t settingsChangeTime = 0;
+
+void setDefaultSettings(Settings& values) {
+    memset(&values, 0, sizeof(values));
+    values.version = SETTINGS_VERSION;
+    values.mode = MODE_CAMERA_1;
+    values.isAudioEnabled = true;
+    values.brightness = 2;
+    LedOutput::getDefaultLayout(values.ledLayout);
+}
+
+bool isValidSettings(const Settings& values) {
+    return values.version == SETTINGS_VERSION
+        && values.mode <= MODE_CAMERA_MAX
+        && values.brightness < BRIGHTNESS_LEVEL_COUNT
+        && LedOutput::isValidLayout(values.ledLayout);
+}
+
+void loadLegacyKeys(Settings& values) {
+    if (preferences.isKey(PREF_MODE_NAME)) {
+        values.mode = min(MODE_CAMERA_MAX, preferences.getUChar(PREF_MODE_NAME, MODE_CAMERA_1));
+    }
+
+    if (preferences.isKey(PREF_AUDIO_NAME)) {
+        values.isAudioEnabled = preferences.getBool(PREF_AUDIO_NAME, true);
+    }
+
+    if (preferences.isKey(PREF_BRIGHTNESS_NAME)) {
+        values.brightness = min(BRIGHTNESS_LEVEL_COUNT - 1, preferences.getUChar(PREF_BRIGHTNESS_NAME, 2));
+    }
+
+    if (preferences.getBytesLength(PREF_LED_LAYOUT_NAME) == sizeof(LedLayout)) {
+        LedLayout stored;
+        preferences.getBytes(PREF_LED_LAYOUT_NAME, &stored, sizeof(stored));
+        if (LedOutput::isValidLayout(stored)) {
+            values.ledLayout = stored;
+        }
+    }
+}
+
+void markSettingsDirty() {
+    settingsStats.isDirty = true;
+    settingsChangeTime = millis();
+}
+
+void SettingsStore::begin() {
+    preferences.begin(PREF_LIB);
+    setDefaultSettings(currentSettings);
+
+    if (preferences.getBytesLength(PREF_SETTINGS_NAME) == sizeof(Settings)) {
+        Settings stored;
+        preferences.getBytes(PREF_SETTINGS_NAME, &stored, sizeof(stored));
+        if (isValidSettings(stored)) {
+            currentSettings = stored;
+            return;
+        }
+    }
+
+    // First boot with the blob, or one that can't be used
+    loadLegacyKeys(currentSettings);
+    commit();
+    preferences.remove(PREF_MODE_NAME);
+    preferences.remove(PREF_AUDIO_NAME);
+    preferences.remove(PREF_BRIGHTNESS_NAME);
+    preferences.remove(PREF_LED_LAYOUT_NAME);
+}
+
+const Settings& SettingsStore::get() {
+    return currentSettings;
+}
+
+void SettingsStore::setMode(uint8_t mode) {
+    if (mode != currentSettings.mode) {
+        currentSettings.mode = mode;
+        markSettingsDirty();
+    }
+}
+
+void SettingsStore::setIsAudioEnabled(bool isAudioEnabled) {
+    if (isAudioEnabled != (currentSettings.isAudioEnabled != 0)) {
+        currentSettings.isAudioEnabled = isAudioEnabled;
+        markSettingsDirty();
+    }
+}
+
+void SettingsStore::setBrightness(uint8_t brightness) {
+    if (brightness != currentSettings.brightness) {
+        currentSettings.brightness = brightness;
+        markSettingsDirty();
+    }
+}
+
+void SettingsStore::setLedLayout(const LedLayout& layout) {
+    if (memcmp(&layout, &currentSettings.ledLayout, sizeof(LedLayout)) != 0) {
+        currentSettings.ledLayout = layout;
+        markSettingsDirty();
+    }
+}
+
+void SettingsStore::update(uint32_t ms) {
+    // Signed, a change made during this update is stamped after ms
+    if (settingsStats.isDirty && (int32_t)(ms - settingsChangeTime) >= SETTINGS_COMMIT_DELAY) {
+        commit();
+    }
+}
+
+void SettingsStore::commit() {
+    uint32_t start = micros();
+    preferences.putBytes(PREF_SETTINGS_NAME, &currentSettings, sizeof(currentSettings));
+    settingsStats.lastCommitTime = micros() - start;
+    settingsStats.commits++;
+    settingsStats.isDirty = false;
+}
+
+const SettingsStats& SettingsStore::getStats() {
+    return settingsStats;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <M5StickCPlus.h>
+#include "ledoutput.h"
+
+#define SETTINGS_VERSION 1
+#define SETTINGS_COMMIT_DELAY 2000  // ms without a change before the values go to NVS
+
+// Every persisted setting, stored as one blob. A change of this struct
+// needs a new SETTINGS_VERSION and a migration in SettingsStore::begin().
+// All fields are bytes so there is no padding in the stored blob.
+typedef struct {
+    uint8_t version;
+    uint8_t mode;
+    uint8_t isAudioEnabled;
+    uint8_t brightness;
+    LedLayout ledLayout;
+} Settings;
+
+typedef struct {
+    uint32_t commits;           // NVS writes since boot
+    uint32_t lastCommitTime;    // us the last write took
+    bool isDirty;               // changes not written yet
+} SettingsStats;
+
+// Write-behind store of the settings. Setters only change the values in
+// RAM, update() writes them to NVS in one go once they stopped changing
+// for SETTINGS_COMMIT_DELAY. Only used from the tally task.
+class SettingsStore {
+public:
+    static void begin();
+
+    static const Settings& get();
+
+    static void setMode(uint8_t mode);
+
+    static void setIsAudioEnabled(bool isAudioEnabled);
+
+    static void setBrightness(uint8_t brightness);
+
+    static void setLedLayout(const LedLayout& layout);
+
+    // Commits when the settings have been quiet long enough
+    static void update(uint32_t ms);
+
+    // Writes pending changes now, e.g. before powering off
+    static void commit();
+
+    static const SettingsStats& getStats();
+};
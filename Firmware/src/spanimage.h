@@ -0,0 +1,25 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+// Draws an image in the run-span format written by tools/xbm2spans.py.
+// Every row lists its runs of set pixels, a row repeated by the following
+// ones is drawn once as rectangles of the full height. Clear pixels are
+// left untouched, like drawXBitmap().
+inline void drawSpanImage(TFT_eSprite& sprite, int32_t x, int32_t y, const uint8_t *data, int16_t height, uint16_t color) {
+    int16_t row = 0;
+    while (row < height) {
+        uint8_t spanCount = *data++;
+        const uint8_t *spans = data;
+        data += spanCount * 2;
+
+        int16_t rows = 1;
+        if (row + 1 < height && (*data & 0x80) != 0) {
+            rows += *data++ & 0x7F;
+        }
+
+        for (uint8_t i = 0; i < spanCount; ++i) {
+            sprite.fillRect(x + spans[i * 2], y + row, spans[i * 2 + 1], rows, color);
+        }
+        row += rows;
+    }
+}
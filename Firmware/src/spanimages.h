@@ -0,0 +1,327 @@
+// Generated by tools/xbm2spans.py from xbmimages.h, do not edit
+#pragma once
+#include <stdint.h>
+
+#define SpanImageWidth 135
+#define SpanImageHeight 240
+
+const uint8_t NumberSpanImage0[] = {
+    0x00, 0xdf, 0x02, 0x09, 0x08, 0x20, 0x08, 0x03, 0x09, 0x08, 0x20, 0x08, 0x77, 0x01, 0x03, 0x09,
+    0x08, 0x20, 0x08, 0x76, 0x02, 0x03, 0x09, 0x08, 0x20, 0x08, 0x74, 0x04, 0x03, 0x09, 0x08, 0x20,
+    0x08, 0x72, 0x06, 0x03, 0x09, 0x08, 0x20, 0x08, 0x71, 0x07, 0x03, 0x09, 0x08, 0x20, 0x08, 0x70,
+    0x08, 0x85, 0x05, 0x09, 0x08, 0x20, 0x08, 0x38, 0x07, 0x55, 0x09, 0x70, 0x08, 0x05, 0x09, 0x08,
+    0x20, 0x08, 0x35, 0x0d, 0x53, 0x0e, 0x6c, 0x11, 0x05, 0x09, 0x08, 0x20, 0x08, 0x34, 0x0f, 0x51,
+    0x11, 0x6c, 0x11, 0x05, 0x09, 0x08, 0x20, 0x08, 0x33, 0x11, 0x51, 0x12, 0x6c, 0x11, 0x05, 0x09,
+    0x08, 0x20, 0x08, 0x32, 0x13, 0x50, 0x14, 0x6c, 0x11, 0x05, 0x09, 0x08, 0x20, 0x08, 0x31, 0x15,
+    0x4f, 0x15, 0x6c, 0x11, 0x05, 0x09, 0x08, 0x20, 0x08, 0x30, 0x17, 0x4f, 0x16, 0x6c, 0x11, 0x06,
+    0x09, 0x1f, 0x30, 0x09, 0x3e, 0x09, 0x4e, 0x09, 0x5c, 0x09, 0x6c, 0x11, 0x06, 0x09, 0x1f, 0x2f,
+    0x09, 0x3f, 0x09, 0x4e, 0x08, 0x5d, 0x09, 0x70, 0x08, 0x06, 0x09, 0x1f, 0x2f, 0x08, 0x40, 0x08,
+    0x4e, 0x08, 0x5e, 0x08, 0x70, 0x08, 0x06, 0x09, 0x1f, 0x2e, 0x09, 0x40, 0x09, 0x4e, 0x08, 0x5e,
+    0x04, 0x70, 0x08, 0x05, 0x09, 0x1f, 0x2e, 0x08, 0x41, 0x08, 0x4e, 0x09, 0x70, 0x08, 0x05, 0x09,
+    0x1f, 0x2e, 0x08, 0x41, 0x08, 0x4e, 0x0a, 0x70, 0x08, 0x05, 0x09, 0x1f, 0x2d, 0x08, 0x42, 0x08,
+    0x4e, 0x0d, 0x70, 0x08, 0x05, 0x09, 0x1f, 0x2d, 0x08, 0x42, 0x08, 0x4e, 0x10, 0x70, 0x08, 0x06,
+    0x09, 0x08, 0x20, 0x08, 0x2d, 0x08, 0x42, 0x08, 0x4f, 0x12, 0x70, 0x08, 0x06, 0x09, 0x08, 0x20,
+    0x08, 0x2d, 0x08, 0x42, 0x08, 0x4f, 0x14, 0x70, 0x08, 0x06, 0x09, 0x08, 0x20, 0x08, 0x2d, 0x08,
+    0x42, 0x08, 0x50, 0x14, 0x70, 0x08, 0x06, 0x09, 0x08, 0x20, 0x08, 0x2d, 0x08, 0x42, 0x08, 0x51,
+    0x14, 0x70, 0x08, 0x06, 0x09, 0x08, 0x20, 0x08, 0x2d, 0x08, 0x42, 0x08, 0x52, 0x14, 0x70, 0x08,
+    0x06, 0x09, 0x08, 0x20, 0x08, 0x2d, 0x08, 0x42, 0x08, 0x54, 0x12, 0x70, 0x08, 0x06, 0x09, 0x08,
+    0x20, 0x08, 0x2d, 0x08, 0x42, 0x08, 0x56, 0x11, 0x70, 0x08, 0x06, 0x09, 0x08, 0x20, 0x08, 0x2d,
+    0x08, 0x42, 0x08, 0x59, 0x0e, 0x70, 0x08, 0x06, 0x09, 0x08, 0x20, 0x08, 0x2d, 0x08, 0x42, 0x08,
+    0x5d, 0x0a, 0x70, 0x08, 0x06, 0x09, 0x08, 0x20, 0x08, 0x2e, 0x08, 0x41, 0x08, 0x5e, 0x09, 0x70,
+    0x08, 0x07, 0x09, 0x08, 0x20, 0x08, 0x2e, 0x08, 0x41, 0x08, 0x51, 0x04, 0x5f, 0x08, 0x70, 0x08,
+    0x07, 0x09, 0x08, 0x20, 0x08, 0x2e, 0x09, 0x40, 0x09, 0x4d, 0x08, 0x5f, 0x08, 0x70, 0x08, 0x07,
+    0x09, 0x08, 0x20, 0x08, 0x2e, 0x09, 0x40, 0x08, 0x4d, 0x09, 0x5f, 0x08, 0x70, 0x08, 0x07, 0x09,
+    0x08, 0x20, 0x08, 0x2f, 0x09, 0x3f, 0x09, 0x4e, 0x08, 0x5e, 0x09, 0x70, 0x08, 0x08, 0x09, 0x08,
+    0x20, 0x08, 0x2f, 0x0a, 0x3e, 0x09, 0x4e, 0x0a, 0x5d, 0x09, 0x70, 0x09, 0x7d, 0x01, 0x05, 0x09,
+    0x08, 0x20, 0x08, 0x30, 0x17, 0x4f, 0x17, 0x70, 0x0e, 0x05, 0x09, 0x08, 0x20, 0x08, 0x31, 0x15,
+    0x4f, 0x16, 0x70, 0x0e, 0x05, 0x09, 0x08, 0x20, 0x08, 0x31, 0x14, 0x50, 0x15, 0x71, 0x0d, 0x05,
+    0x09, 0x08, 0x20, 0x08, 0x32, 0x12, 0x51, 0x13, 0x71, 0x0d, 0x05, 0x09, 0x08, 0x20, 0x08, 0x34,
+    0x0f, 0x52, 0x11, 0x72, 0x0c, 0x05, 0x09, 0x08, 0x20, 0x08, 0x35, 0x0d, 0x53, 0x0e, 0x73, 0x0b,
+    0x03, 0x38, 0x07, 0x56, 0x09, 0x75, 0x07, 0x00, 0xde,
+};
+
+const uint8_t NumberSpanImage1[] = {
+    0x00, 0xa6, 0x01, 0x4c, 0x14, 0x01, 0x4b, 0x15, 0x82, 0x01, 0x4a, 0x16, 0x82, 0x01, 0x49, 0x17,
+    0x81, 0x01, 0x48, 0x18, 0x81, 0x01, 0x47, 0x19, 0x81, 0x01, 0x46, 0x1a, 0x01, 0x45, 0x1b, 0x81,
+    0x01, 0x44, 0x1c, 0x01, 0x43, 0x1d, 0x81, 0x01, 0x42, 0x1e, 0x01, 0x41, 0x1f, 0x01, 0x40, 0x20,
+    0x01, 0x3f, 0x21, 0x81, 0x01, 0x3e, 0x22, 0x01, 0x3d, 0x23, 0x01, 0x3c, 0x24, 0x01, 0x3a, 0x26,
+    0x01, 0x39, 0x27, 0x01, 0x38, 0x28, 0x01, 0x37, 0x29, 0x01, 0x36, 0x2a, 0x01, 0x35, 0x2b, 0x01,
+    0x33, 0x2d, 0x01, 0x32, 0x2e, 0x01, 0x31, 0x2f, 0x01, 0x2f, 0x31, 0x01, 0x2e, 0x32, 0x01, 0x2c,
+    0x34, 0x01, 0x2a, 0x36, 0x01, 0x28, 0x38, 0x01, 0x27, 0x39, 0x84, 0x02, 0x27, 0x1f, 0x47, 0x19,
+    0x02, 0x27, 0x1e, 0x47, 0x19, 0x02, 0x27, 0x1d, 0x47, 0x19, 0x02, 0x27, 0x1c, 0x47, 0x19, 0x81,
+    0x02, 0x27, 0x1b, 0x47, 0x19, 0x02, 0x27, 0x19, 0x47, 0x19, 0x02, 0x27, 0x18, 0x47, 0x19, 0x02,
+    0x27, 0x17, 0x47, 0x19, 0x02, 0x27, 0x16, 0x47, 0x19, 0x02, 0x27, 0x15, 0x47, 0x19, 0x02, 0x27,
+    0x14, 0x47, 0x19, 0x02, 0x27, 0x12, 0x47, 0x19, 0x02, 0x27, 0x11, 0x47, 0x19, 0x02, 0x27, 0x10,
+    0x47, 0x19, 0x02, 0x27, 0x0e, 0x47, 0x19, 0x02, 0x27, 0x0d, 0x47, 0x19, 0x02, 0x27, 0x0b, 0x47,
+    0x19, 0x02, 0x27, 0x09, 0x47, 0x19, 0x02, 0x27, 0x07, 0x47, 0x19, 0x02, 0x27, 0x06, 0x47, 0x19,
+    0x02, 0x27, 0x03, 0x47, 0x19, 0x02, 0x27, 0x01, 0x47, 0x19, 0x01, 0x47, 0x19, 0xdc, 0x00, 0xa6,
+};
+
+const uint8_t NumberSpanImage2[] = {
+    0x00, 0xa6, 0x01, 0x3f, 0x0e, 0x01, 0x3a, 0x18, 0x01, 0x37, 0x1e, 0x01, 0x34, 0x24, 0x01, 0x32,
+    0x28, 0x01, 0x30, 0x2c, 0x01, 0x2f, 0x2e, 0x01, 0x2d, 0x31, 0x01, 0x2c, 0x34, 0x01, 0x2a, 0x37,
+    0x01, 0x29, 0x39, 0x01, 0x28, 0x3b, 0x01, 0x27, 0x3d, 0x01, 0x26, 0x3f, 0x81, 0x01, 0x25, 0x41,
+    0x01, 0x24, 0x43, 0x01, 0x23, 0x45, 0x81, 0x01, 0x22, 0x47, 0x81, 0x01, 0x21, 0x49, 0x81, 0x01,
+    0x20, 0x4b, 0x81, 0x01, 0x20, 0x4c, 0x02, 0x1f, 0x22, 0x4a, 0x22, 0x02, 0x1f, 0x1f, 0x4d, 0x1f,
+    0x02, 0x1e, 0x1f, 0x4e, 0x1f, 0x02, 0x1e, 0x1d, 0x50, 0x1d, 0x02, 0x1e, 0x1c, 0x51, 0x1c, 0x02,
+    0x1e, 0x1b, 0x52, 0x1b, 0x02, 0x1d, 0x1c, 0x52, 0x1c, 0x02, 0x1d, 0x1b, 0x53, 0x1b, 0x02, 0x1d,
+    0x1a, 0x53, 0x1b, 0x02, 0x1d, 0x1a, 0x54, 0x1a, 0x02, 0x1c, 0x1a, 0x54, 0x1a, 0x02, 0x1c, 0x1a,
+    0x55, 0x1a, 0x82, 0x02, 0x1c, 0x19, 0x55, 0x1a, 0x02, 0x1c, 0x19, 0x56, 0x19, 0x02, 0x1b, 0x1a,
+    0x56, 0x19, 0x82, 0x02, 0x1b, 0x19, 0x56, 0x19, 0x81, 0x02, 0x1f, 0x15, 0x56, 0x19, 0x02, 0x27,
+    0x0d, 0x56, 0x19, 0x02, 0x30, 0x04, 0x56, 0x19, 0x01, 0x56, 0x19, 0x82, 0x01, 0x55, 0x19, 0x84,
+    0x01, 0x54, 0x1a, 0x01, 0x54, 0x19, 0x81, 0x01, 0x53, 0x1a, 0x81, 0x01, 0x52, 0x1a, 0x81, 0x01,
+    0x51, 0x1b, 0x81, 0x01, 0x50, 0x1b, 0x81, 0x01, 0x4f, 0x1b, 0x01, 0x4e, 0x1c, 0x01, 0x4d, 0x1d,
+    0x01, 0x4d, 0x1c, 0x01, 0x4c, 0x1d, 0x01, 0x4b, 0x1d, 0x01, 0x4a, 0x1e, 0x01, 0x4a, 0x1d, 0x01,
+    0x49, 0x1e, 0x01, 0x48, 0x1e, 0x01, 0x47, 0x1f, 0x01, 0x47, 0x1e, 0x01, 0x46, 0x1f, 0x01, 0x45,
+    0x1f, 0x01, 0x44, 0x20, 0x01, 0x43, 0x20, 0x01, 0x42, 0x20, 0x81, 0x01, 0x41, 0x20, 0x01, 0x40,
+    0x20, 0x01, 0x3f, 0x21, 0x01, 0x3e, 0x21, 0x01, 0x3d, 0x21, 0x01, 0x3c, 0x21, 0x81, 0x01, 0x3b,
+    0x21, 0x01, 0x3a, 0x21, 0x01, 0x39, 0x21, 0x01, 0x38, 0x21, 0x01, 0x37, 0x22, 0x01, 0x36, 0x22,
+    0x01, 0x36, 0x21, 0x01, 0x35, 0x21, 0x01, 0x34, 0x21, 0x01, 0x33, 0x21, 0x01, 0x32, 0x21, 0x81,
+    0x01, 0x31, 0x21, 0x01, 0x30, 0x21, 0x01, 0x2f, 0x21, 0x01, 0x2e, 0x21, 0x01, 0x2e, 0x20, 0x01,
+    0x2d, 0x20, 0x01, 0x2c, 0x20, 0x01, 0x2b, 0x21, 0x01, 0x2b, 0x20, 0x01, 0x2a, 0x20, 0x01, 0x29,
+    0x20, 0x01, 0x29, 0x1f, 0x01, 0x28, 0x1f, 0x01, 0x27, 0x1f, 0x81, 0x01, 0x26, 0x1f, 0x01, 0x25,
+    0x1f, 0x01, 0x25, 0x1e, 0x01, 0x24, 0x1e, 0x81, 0x01, 0x23, 0x1e, 0x01, 0x22, 0x1e, 0x81, 0x01,
+    0x21, 0x1e, 0x81, 0x01, 0x20, 0x1e, 0x81, 0x01, 0x1f, 0x50, 0x82, 0x01, 0x1e, 0x51, 0x81, 0x01,
+    0x1d, 0x52, 0x82, 0x01, 0x1c, 0x53, 0x82, 0x01, 0x1b, 0x54, 0x82, 0x01, 0x1a, 0x55, 0x84, 0x01,
+    0x19, 0x56, 0x85, 0x01, 0x18, 0x57, 0x83, 0x00, 0xa6,
+};
+
+const uint8_t NumberSpanImage3[] = {
+    0x00, 0xa5, 0x01, 0x3d, 0x0d, 0x01, 0x38, 0x16, 0x01, 0x36, 0x1b, 0x01, 0x33, 0x20, 0x01, 0x31,
+    0x24, 0x01, 0x30, 0x27, 0x01, 0x2e, 0x2a, 0x01, 0x2d, 0x2c, 0x01, 0x2c, 0x2e, 0x01, 0x2a, 0x31,
+    0x01, 0x29, 0x33, 0x01, 0x28, 0x35, 0x01, 0x28, 0x36, 0x01, 0x27, 0x38, 0x01, 0x26, 0x3a, 0x01,
+    0x25, 0x3c, 0x81, 0x01, 0x24, 0x3e, 0x01, 0x23, 0x40, 0x81, 0x01, 0x22, 0x42, 0x81, 0x01, 0x21,
+    0x44, 0x81, 0x01, 0x21, 0x45, 0x01, 0x20, 0x46, 0x02, 0x20, 0x1f, 0x46, 0x20, 0x02, 0x20, 0x1d,
+    0x49, 0x1e, 0x02, 0x1f, 0x1c, 0x4a, 0x1d, 0x02, 0x1f, 0x1b, 0x4b, 0x1c, 0x02, 0x1f, 0x1a, 0x4c,
+    0x1c, 0x02, 0x1e, 0x1a, 0x4d, 0x1b, 0x81, 0x02, 0x1e, 0x19, 0x4e, 0x1a, 0x02, 0x1e, 0x18, 0x4e,
+    0x1a, 0x02, 0x1d, 0x19, 0x4f, 0x1a, 0x02, 0x1d, 0x18, 0x4f, 0x1a, 0x81, 0x02, 0x1d, 0x18, 0x50,
+    0x19, 0x02, 0x1d, 0x17, 0x50, 0x19, 0x02, 0x1c, 0x18, 0x50, 0x19, 0x82, 0x02, 0x1e, 0x16, 0x50,
+    0x19, 0x02, 0x23, 0x10, 0x50, 0x19, 0x02, 0x27, 0x0c, 0x50, 0x19, 0x02, 0x2c, 0x07, 0x50, 0x19,
+    0x02, 0x31, 0x02, 0x50, 0x19, 0x01, 0x50, 0x19, 0x01, 0x50, 0x18, 0x01, 0x4f, 0x19, 0x82, 0x01,
+    0x4e, 0x1a, 0x01, 0x4e, 0x19, 0x81, 0x01, 0x4d, 0x1a, 0x01, 0x4d, 0x19, 0x01, 0x4c, 0x1a, 0x01,
+    0x4b, 0x1a, 0x01, 0x4a, 0x1b, 0x01, 0x49, 0x1b, 0x01, 0x48, 0x1c, 0x01, 0x46, 0x1d, 0x01, 0x43,
+    0x20, 0x01, 0x3d, 0x25, 0x01, 0x3c, 0x25, 0x01, 0x3c, 0x24, 0x81, 0x01, 0x3c, 0x23, 0x01, 0x3c,
+    0x22, 0x01, 0x3c, 0x21, 0x01, 0x3c, 0x20, 0x01, 0x3c, 0x1f, 0x01, 0x3c, 0x1d, 0x01, 0x3c, 0x1c,
+    0x01, 0x3b, 0x1c, 0x01, 0x3b, 0x1e, 0x01, 0x3b, 0x20, 0x01, 0x3b, 0x22, 0x01, 0x3b, 0x24, 0x01,
+    0x3b, 0x25, 0x01, 0x3b, 0x27, 0x01, 0x3b, 0x28, 0x01, 0x3b, 0x29, 0x01, 0x3b, 0x2a, 0x01, 0x3a,
+    0x2c, 0x01, 0x3a, 0x2d, 0x81, 0x02, 0x3a, 0x06, 0x48, 0x20, 0x02, 0x3a, 0x02, 0x4b, 0x1e, 0x01,
+    0x4c, 0x1d, 0x01, 0x4e, 0x1c, 0x01, 0x4f, 0x1b, 0x01, 0x4f, 0x1c, 0x01, 0x50, 0x1b, 0x01, 0x51,
+    0x1b, 0x01, 0x52, 0x1a, 0x81, 0x01, 0x53, 0x1a, 0x82, 0x01, 0x54, 0x1a, 0x84, 0x01, 0x55, 0x1a,
+    0x87, 0x02, 0x2e, 0x03, 0x55, 0x1a, 0x02, 0x27, 0x0a, 0x55, 0x1a, 0x02, 0x21, 0x10, 0x55, 0x1a,
+    0x02, 0x1a, 0x17, 0x55, 0x1a, 0x02, 0x19, 0x19, 0x55, 0x1a, 0x02, 0x19, 0x19, 0x54, 0x1b, 0x82,
+    0x02, 0x1a, 0x19, 0x54, 0x1a, 0x81, 0x02, 0x1a, 0x19, 0x53, 0x1b, 0x02, 0x1a, 0x1a, 0x53, 0x1b,
+    0x02, 0x1a, 0x1a, 0x52, 0x1c, 0x02, 0x1b, 0x19, 0x52, 0x1b, 0x02, 0x1b, 0x1a, 0x51, 0x1c, 0x81,
+    0x02, 0x1b, 0x1b, 0x50, 0x1d, 0x02, 0x1c, 0x1b, 0x4f, 0x1d, 0x02, 0x1c, 0x1c, 0x4f, 0x1d, 0x02,
+    0x1c, 0x1d, 0x4e, 0x1e, 0x02, 0x1d, 0x1d, 0x4d, 0x1e, 0x02, 0x1d, 0x1e, 0x4b, 0x20, 0x02, 0x1d,
+    0x20, 0x4a, 0x20, 0x02, 0x1e, 0x21, 0x47, 0x23, 0x01, 0x1e, 0x4c, 0x01, 0x1f, 0x4a, 0x81, 0x01,
+    0x20, 0x48, 0x01, 0x20, 0x47, 0x01, 0x21, 0x46, 0x01, 0x21, 0x45, 0x01, 0x22, 0x43, 0x01, 0x23,
+    0x42, 0x01, 0x23, 0x41, 0x01, 0x24, 0x3f, 0x01, 0x25, 0x3d, 0x01, 0x26, 0x3b, 0x01, 0x27, 0x3a,
+    0x01, 0x28, 0x38, 0x01, 0x29, 0x36, 0x01, 0x2a, 0x33, 0x01, 0x2b, 0x31, 0x01, 0x2c, 0x2f, 0x01,
+    0x2e, 0x2c, 0x01, 0x2f, 0x29, 0x01, 0x31, 0x25, 0x01, 0x33, 0x21, 0x01, 0x35, 0x1d, 0x01, 0x38,
+    0x17, 0x01, 0x3d, 0x0d, 0x00, 0xa4,
+};
+
+const uint8_t NumberSpanImage4[] = {
+    0x00, 0xa6, 0x01, 0x4c, 0x16, 0x81, 0x01, 0x4b, 0x17, 0x01, 0x4a, 0x18, 0x81, 0x01, 0x49, 0x19,
+    0x81, 0x01, 0x48, 0x1a, 0x81, 0x01, 0x47, 0x1b, 0x81, 0x01, 0x46, 0x1c, 0x81, 0x01, 0x45, 0x1d,
+    0x81, 0x01, 0x44, 0x1e, 0x01, 0x43, 0x1f, 0x81, 0x01, 0x42, 0x20, 0x81, 0x01, 0x41, 0x21, 0x81,
+    0x01, 0x40, 0x22, 0x81, 0x01, 0x3f, 0x23, 0x81, 0x01, 0x3e, 0x24, 0x81, 0x01, 0x3d, 0x25, 0x01,
+    0x3c, 0x26, 0x81, 0x01, 0x3b, 0x27, 0x81, 0x01, 0x3a, 0x28, 0x81, 0x01, 0x39, 0x29, 0x81, 0x01,
+    0x38, 0x2a, 0x81, 0x01, 0x37, 0x2b, 0x81, 0x01, 0x36, 0x2c, 0x81, 0x01, 0x35, 0x2d, 0x01, 0x34,
+    0x2e, 0x81, 0x01, 0x33, 0x2f, 0x81, 0x01, 0x32, 0x30, 0x81, 0x02, 0x31, 0x17, 0x49, 0x19, 0x02,
+    0x31, 0x16, 0x49, 0x19, 0x02, 0x30, 0x17, 0x49, 0x19, 0x02, 0x30, 0x16, 0x49, 0x19, 0x02, 0x2f,
+    0x17, 0x49, 0x19, 0x02, 0x2f, 0x16, 0x49, 0x19, 0x02, 0x2e, 0x17, 0x49, 0x19, 0x02, 0x2d, 0x17,
+    0x49, 0x19, 0x81, 0x02, 0x2c, 0x17, 0x49, 0x19, 0x81, 0x02, 0x2b, 0x17, 0x49, 0x19, 0x81, 0x02,
+    0x2a, 0x17, 0x49, 0x19, 0x81, 0x02, 0x29, 0x17, 0x49, 0x19, 0x02, 0x29, 0x16, 0x49, 0x19, 0x02,
+    0x28, 0x17, 0x49, 0x19, 0x02, 0x28, 0x16, 0x49, 0x19, 0x02, 0x27, 0x17, 0x49, 0x19, 0x02, 0x26,
+    0x17, 0x49, 0x19, 0x81, 0x02, 0x25, 0x17, 0x49, 0x19, 0x81, 0x02, 0x24, 0x17, 0x49, 0x19, 0x81,
+    0x02, 0x23, 0x17, 0x49, 0x19, 0x81, 0x02, 0x22, 0x17, 0x49, 0x19, 0x02, 0x22, 0x16, 0x49, 0x19,
+    0x02, 0x21, 0x17, 0x49, 0x19, 0x02, 0x21, 0x16, 0x49, 0x19, 0x02, 0x20, 0x17, 0x49, 0x19, 0x02,
+    0x20, 0x16, 0x49, 0x19, 0x02, 0x1f, 0x17, 0x49, 0x19, 0x02, 0x1e, 0x17, 0x49, 0x19, 0x81, 0x02,
+    0x1d, 0x17, 0x49, 0x19, 0x81, 0x02, 0x1c, 0x17, 0x49, 0x19, 0x81, 0x02, 0x1b, 0x17, 0x49, 0x19,
+    0x02, 0x1b, 0x16, 0x49, 0x19, 0x02, 0x1a, 0x17, 0x49, 0x19, 0x02, 0x1a, 0x16, 0x49, 0x19, 0x02,
+    0x19, 0x17, 0x49, 0x19, 0x02, 0x19, 0x16, 0x49, 0x19, 0x02, 0x18, 0x17, 0x49, 0x19, 0x02, 0x17,
+    0x17, 0x49, 0x19, 0x81, 0x02, 0x16, 0x17, 0x49, 0x19, 0x81, 0x02, 0x15, 0x17, 0x49, 0x19, 0x01,
+    0x15, 0x5d, 0x9a, 0x01, 0x49, 0x19, 0x9f, 0x00, 0xa6,
+};
+
+const uint8_t NumberSpanImage5[] = {
+    0x00, 0xa6, 0x01, 0x28, 0x42, 0x82, 0x01, 0x27, 0x43, 0x86, 0x01, 0x26, 0x44, 0x85, 0x01, 0x25,
+    0x45, 0x86, 0x01, 0x24, 0x46, 0x85, 0x01, 0x24, 0x17, 0x01, 0x23, 0x18, 0x01, 0x23, 0x17, 0x84,
+    0x01, 0x22, 0x18, 0x81, 0x01, 0x22, 0x17, 0x84, 0x01, 0x21, 0x18, 0x01, 0x21, 0x17, 0x84, 0x01,
+    0x20, 0x18, 0x81, 0x02, 0x20, 0x17, 0x42, 0x0c, 0x02, 0x20, 0x17, 0x3f, 0x13, 0x02, 0x20, 0x17,
+    0x3c, 0x19, 0x02, 0x20, 0x17, 0x3a, 0x1d, 0x02, 0x20, 0x17, 0x38, 0x21, 0x01, 0x1f, 0x3b, 0x01,
+    0x1f, 0x3d, 0x01, 0x1f, 0x3e, 0x01, 0x1f, 0x3f, 0x01, 0x1f, 0x40, 0x01, 0x1f, 0x41, 0x01, 0x1e,
+    0x43, 0x01, 0x1e, 0x44, 0x01, 0x1e, 0x45, 0x01, 0x1e, 0x46, 0x01, 0x1e, 0x47, 0x81, 0x01, 0x1e,
+    0x48, 0x01, 0x1d, 0x4a, 0x81, 0x01, 0x1d, 0x4b, 0x01, 0x1d, 0x4c, 0x81, 0x01, 0x1d, 0x4d, 0x01,
+    0x1c, 0x4e, 0x01, 0x1c, 0x4f, 0x02, 0x1c, 0x22, 0x47, 0x24, 0x02, 0x1c, 0x1f, 0x4a, 0x21, 0x02,
+    0x1c, 0x1d, 0x4c, 0x20, 0x02, 0x1c, 0x1b, 0x4d, 0x1f, 0x02, 0x1c, 0x1a, 0x4e, 0x1f, 0x02, 0x1b,
+    0x1a, 0x4f, 0x1e, 0x02, 0x1b, 0x19, 0x50, 0x1d, 0x02, 0x1b, 0x18, 0x51, 0x1c, 0x02, 0x1c, 0x16,
+    0x52, 0x1c, 0x02, 0x22, 0x0f, 0x52, 0x1c, 0x02, 0x27, 0x09, 0x53, 0x1b, 0x02, 0x2c, 0x03, 0x53,
+    0x1b, 0x01, 0x54, 0x1b, 0x83, 0x01, 0x55, 0x1a, 0x81, 0x01, 0x55, 0x1b, 0x82, 0x01, 0x56, 0x1a,
+    0x8e, 0x02, 0x2c, 0x04, 0x56, 0x1a, 0x02, 0x25, 0x0b, 0x55, 0x1a, 0x02, 0x1d, 0x13, 0x55, 0x1a,
+    0x02, 0x18, 0x18, 0x55, 0x1a, 0x02, 0x18, 0x19, 0x55, 0x1a, 0x81, 0x02, 0x18, 0x19, 0x54, 0x1b,
+    0x02, 0x19, 0x18, 0x54, 0x1a, 0x02, 0x19, 0x19, 0x54, 0x1a, 0x81, 0x02, 0x19, 0x1a, 0x53, 0x1b,
+    0x02, 0x19, 0x1a, 0x53, 0x1a, 0x02, 0x1a, 0x1a, 0x52, 0x1b, 0x81, 0x02, 0x1a, 0x1b, 0x51, 0x1c,
+    0x02, 0x1a, 0x1b, 0x50, 0x1c, 0x02, 0x1b, 0x1b, 0x50, 0x1c, 0x02, 0x1b, 0x1c, 0x4f, 0x1d, 0x02,
+    0x1b, 0x1d, 0x4e, 0x1d, 0x02, 0x1c, 0x1d, 0x4d, 0x1e, 0x02, 0x1c, 0x1f, 0x4b, 0x1f, 0x02, 0x1c,
+    0x20, 0x4a, 0x20, 0x02, 0x1d, 0x22, 0x47, 0x22, 0x01, 0x1d, 0x4c, 0x01, 0x1e, 0x4a, 0x81, 0x01,
+    0x1f, 0x48, 0x81, 0x01, 0x20, 0x46, 0x01, 0x20, 0x45, 0x01, 0x21, 0x44, 0x01, 0x22, 0x42, 0x01,
+    0x22, 0x41, 0x01, 0x23, 0x40, 0x01, 0x24, 0x3e, 0x01, 0x25, 0x3c, 0x01, 0x26, 0x3a, 0x01, 0x27,
+    0x38, 0x01, 0x28, 0x36, 0x01, 0x29, 0x34, 0x01, 0x2a, 0x32, 0x01, 0x2b, 0x30, 0x01, 0x2c, 0x2d,
+    0x01, 0x2e, 0x2a, 0x01, 0x30, 0x26, 0x01, 0x32, 0x22, 0x01, 0x34, 0x1e, 0x01, 0x37, 0x17, 0x01,
+    0x3c, 0x0e, 0x00, 0xa6,
+};
+
+const uint8_t NumberSpanImage6[] = {
+    0x00, 0xa5, 0x01, 0x41, 0x0d, 0x01, 0x3d, 0x15, 0x01, 0x3a, 0x1b, 0x01, 0x37, 0x20, 0x01, 0x35,
+    0x24, 0x01, 0x34, 0x27, 0x01, 0x32, 0x2a, 0x01, 0x31, 0x2c, 0x01, 0x2f, 0x30, 0x01, 0x2e, 0x32,
+    0x01, 0x2d, 0x34, 0x01, 0x2c, 0x36, 0x01, 0x2b, 0x37, 0x01, 0x2a, 0x39, 0x01, 0x29, 0x3b, 0x01,
+    0x28, 0x3d, 0x81, 0x01, 0x27, 0x3f, 0x01, 0x26, 0x40, 0x01, 0x25, 0x42, 0x81, 0x01, 0x24, 0x44,
+    0x01, 0x23, 0x45, 0x01, 0x23, 0x46, 0x01, 0x22, 0x47, 0x81, 0x02, 0x21, 0x22, 0x4a, 0x20, 0x02,
+    0x21, 0x1f, 0x4d, 0x1d, 0x02, 0x20, 0x1f, 0x4e, 0x1c, 0x02, 0x20, 0x1d, 0x4f, 0x1c, 0x02, 0x20,
+    0x1c, 0x50, 0x1b, 0x02, 0x1f, 0x1c, 0x51, 0x1a, 0x02, 0x1f, 0x1c, 0x52, 0x19, 0x02, 0x1f, 0x1b,
+    0x52, 0x1a, 0x02, 0x1e, 0x1b, 0x53, 0x19, 0x81, 0x02, 0x1e, 0x1a, 0x54, 0x18, 0x02, 0x1d, 0x1b,
+    0x54, 0x19, 0x02, 0x1d, 0x1a, 0x54, 0x19, 0x81, 0x02, 0x1c, 0x1a, 0x55, 0x18, 0x02, 0x1c, 0x1a,
+    0x55, 0x12, 0x02, 0x1c, 0x1a, 0x55, 0x0b, 0x02, 0x1c, 0x19, 0x55, 0x04, 0x01, 0x1c, 0x19, 0x01,
+    0x1b, 0x1a, 0x82, 0x01, 0x1b, 0x19, 0x81, 0x01, 0x1a, 0x1a, 0x83, 0x01, 0x1a, 0x19, 0x82, 0x01,
+    0x19, 0x1a, 0x02, 0x19, 0x1a, 0x44, 0x0b, 0x02, 0x19, 0x1a, 0x41, 0x12, 0x02, 0x19, 0x1a, 0x3e,
+    0x18, 0x02, 0x19, 0x1a, 0x3c, 0x1c, 0x02, 0x19, 0x1a, 0x3b, 0x1f, 0x02, 0x19, 0x19, 0x39, 0x22,
+    0x02, 0x19, 0x19, 0x38, 0x25, 0x02, 0x19, 0x19, 0x37, 0x27, 0x02, 0x19, 0x19, 0x36, 0x29, 0x02,
+    0x18, 0x1a, 0x35, 0x2b, 0x02, 0x18, 0x1a, 0x34, 0x2d, 0x02, 0x18, 0x1a, 0x33, 0x2f, 0x02, 0x18,
+    0x1a, 0x33, 0x30, 0x01, 0x18, 0x4c, 0x01, 0x18, 0x4d, 0x81, 0x01, 0x18, 0x4e, 0x01, 0x18, 0x4f,
+    0x81, 0x01, 0x18, 0x50, 0x01, 0x18, 0x51, 0x81, 0x01, 0x18, 0x52, 0x02, 0x18, 0x2a, 0x4a, 0x20,
+    0x02, 0x18, 0x27, 0x4c, 0x1f, 0x02, 0x18, 0x26, 0x4e, 0x1d, 0x02, 0x18, 0x24, 0x4f, 0x1c, 0x02,
+    0x18, 0x23, 0x51, 0x1b, 0x02, 0x18, 0x22, 0x51, 0x1b, 0x02, 0x18, 0x21, 0x52, 0x1b, 0x02, 0x18,
+    0x21, 0x53, 0x1a, 0x02, 0x18, 0x20, 0x54, 0x19, 0x81, 0x02, 0x18, 0x1f, 0x55, 0x19, 0x81, 0x02,
+    0x18, 0x1e, 0x56, 0x18, 0x81, 0x02, 0x18, 0x1e, 0x56, 0x19, 0x02, 0x18, 0x1d, 0x56, 0x19, 0x02,
+    0x18, 0x1d, 0x57, 0x18, 0x82, 0x02, 0x19, 0x1b, 0x57, 0x18, 0x02, 0x19, 0x1b, 0x57, 0x19, 0x02,
+    0x19, 0x1b, 0x58, 0x18, 0x87, 0x02, 0x1a, 0x1a, 0x58, 0x18, 0x85, 0x02, 0x1a, 0x1b, 0x58, 0x18,
+    0x02, 0x1b, 0x1a, 0x58, 0x18, 0x82, 0x02, 0x1b, 0x1a, 0x57, 0x18, 0x02, 0x1b, 0x1b, 0x57, 0x18,
+    0x02, 0x1c, 0x1a, 0x57, 0x18, 0x82, 0x02, 0x1c, 0x1b, 0x56, 0x19, 0x02, 0x1d, 0x1a, 0x56, 0x19,
+    0x02, 0x1d, 0x1b, 0x56, 0x18, 0x02, 0x1d, 0x1b, 0x55, 0x19, 0x02, 0x1d, 0x1c, 0x55, 0x19, 0x02,
+    0x1e, 0x1c, 0x54, 0x1a, 0x02, 0x1e, 0x1c, 0x54, 0x19, 0x02, 0x1e, 0x1d, 0x53, 0x1a, 0x02, 0x1f,
+    0x1d, 0x52, 0x1b, 0x02, 0x1f, 0x1e, 0x51, 0x1b, 0x02, 0x1f, 0x1f, 0x50, 0x1c, 0x02, 0x20, 0x1f,
+    0x4f, 0x1d, 0x02, 0x20, 0x21, 0x4d, 0x1e, 0x02, 0x21, 0x23, 0x4b, 0x20, 0x01, 0x21, 0x4a, 0x01,
+    0x22, 0x48, 0x81, 0x01, 0x23, 0x46, 0x81, 0x01, 0x24, 0x44, 0x01, 0x25, 0x42, 0x81, 0x01, 0x26,
+    0x40, 0x01, 0x27, 0x3e, 0x81, 0x01, 0x28, 0x3c, 0x01, 0x29, 0x3a, 0x01, 0x2a, 0x38, 0x01, 0x2b,
+    0x36, 0x01, 0x2c, 0x34, 0x01, 0x2d, 0x32, 0x01, 0x2e, 0x30, 0x01, 0x2f, 0x2e, 0x01, 0x31, 0x2a,
+    0x01, 0x32, 0x28, 0x01, 0x34, 0x24, 0x01, 0x36, 0x20, 0x01, 0x38, 0x1c, 0x01, 0x3b, 0x16, 0x01,
+    0x3f, 0x0d, 0x00, 0xa4,
+};
+
+const uint8_t NumberSpanImage7[] = {
+    0x00, 0xa8, 0x01, 0x19, 0x56, 0x96, 0x01, 0x19, 0x55, 0x01, 0x19, 0x54, 0x01, 0x19, 0x53, 0x81,
+    0x01, 0x19, 0x52, 0x01, 0x19, 0x51, 0x01, 0x52, 0x17, 0x01, 0x51, 0x18, 0x01, 0x51, 0x17, 0x01,
+    0x50, 0x17, 0x01, 0x4f, 0x18, 0x01, 0x4f, 0x17, 0x01, 0x4e, 0x18, 0x01, 0x4e, 0x17, 0x01, 0x4d,
+    0x17, 0x01, 0x4c, 0x18, 0x01, 0x4c, 0x17, 0x01, 0x4b, 0x18, 0x01, 0x4b, 0x17, 0x01, 0x4a, 0x18,
+    0x01, 0x49, 0x18, 0x81, 0x01, 0x48, 0x18, 0x01, 0x48, 0x17, 0x01, 0x47, 0x18, 0x01, 0x47, 0x17,
+    0x01, 0x46, 0x18, 0x01, 0x46, 0x17, 0x01, 0x45, 0x18, 0x01, 0x45, 0x17, 0x01, 0x44, 0x18, 0x81,
+    0x01, 0x43, 0x18, 0x81, 0x01, 0x42, 0x18, 0x81, 0x01, 0x41, 0x18, 0x81, 0x01, 0x41, 0x17, 0x01,
+    0x40, 0x18, 0x01, 0x40, 0x17, 0x01, 0x3f, 0x18, 0x81, 0x01, 0x3e, 0x18, 0x81, 0x01, 0x3e, 0x17,
+    0x01, 0x3d, 0x18, 0x81, 0x01, 0x3c, 0x18, 0x81, 0x01, 0x3c, 0x17, 0x01, 0x3b, 0x18, 0x81, 0x01,
+    0x3a, 0x18, 0x82, 0x01, 0x39, 0x18, 0x82, 0x01, 0x38, 0x18, 0x82, 0x01, 0x37, 0x18, 0x82, 0x01,
+    0x36, 0x18, 0x82, 0x01, 0x35, 0x18, 0x82, 0x01, 0x34, 0x19, 0x01, 0x34, 0x18, 0x81, 0x01, 0x33,
+    0x19, 0x01, 0x33, 0x18, 0x82, 0x01, 0x32, 0x19, 0x01, 0x32, 0x18, 0x82, 0x01, 0x31, 0x19, 0x81,
+    0x01, 0x31, 0x18, 0x81, 0x01, 0x30, 0x19, 0x81, 0x01, 0x30, 0x18, 0x81, 0x01, 0x2f, 0x19, 0x82,
+    0x01, 0x2f, 0x18, 0x81, 0x01, 0x2e, 0x19, 0x83, 0x01, 0x2e, 0x18, 0x01, 0x2d, 0x19, 0x84, 0x01,
+    0x2d, 0x18, 0x81, 0x01, 0x2c, 0x19, 0x84, 0x01, 0x2c, 0x18, 0x81, 0x01, 0x2b, 0x19, 0x87, 0x01,
+    0x2b, 0x18, 0x82, 0x01, 0x2a, 0x19, 0x8a, 0x00, 0xa7,
+};
+
+const uint8_t NumberSpanImage8[] = {
+    0x00, 0xa5, 0x01, 0x3c, 0x0e, 0x01, 0x37, 0x18, 0x01, 0x34, 0x1e, 0x01, 0x31, 0x24, 0x01, 0x2f,
+    0x28, 0x01, 0x2d, 0x2b, 0x01, 0x2c, 0x2e, 0x01, 0x2b, 0x30, 0x01, 0x29, 0x34, 0x01, 0x28, 0x36,
+    0x01, 0x27, 0x38, 0x01, 0x26, 0x3a, 0x81, 0x01, 0x25, 0x3c, 0x01, 0x24, 0x3e, 0x01, 0x23, 0x40,
+    0x81, 0x01, 0x22, 0x42, 0x01, 0x21, 0x44, 0x81, 0x01, 0x20, 0x46, 0x81, 0x01, 0x1f, 0x47, 0x01,
+    0x1f, 0x48, 0x81, 0x02, 0x1e, 0x21, 0x48, 0x20, 0x02, 0x1e, 0x1f, 0x4a, 0x1e, 0x02, 0x1e, 0x1d,
+    0x4c, 0x1c, 0x02, 0x1e, 0x1c, 0x4d, 0x1b, 0x02, 0x1d, 0x1c, 0x4e, 0x1b, 0x02, 0x1d, 0x1b, 0x4f,
+    0x1a, 0x02, 0x1d, 0x1a, 0x50, 0x19, 0x81, 0x02, 0x1d, 0x19, 0x51, 0x18, 0x02, 0x1c, 0x1a, 0x51,
+    0x19, 0x02, 0x1c, 0x19, 0x52, 0x18, 0x82, 0x02, 0x1c, 0x18, 0x53, 0x17, 0x89, 0x02, 0x1d, 0x17,
+    0x53, 0x16, 0x02, 0x1d, 0x17, 0x52, 0x17, 0x02, 0x1d, 0x18, 0x52, 0x17, 0x82, 0x02, 0x1e, 0x18,
+    0x51, 0x17, 0x81, 0x02, 0x1e, 0x19, 0x50, 0x18, 0x02, 0x1f, 0x18, 0x50, 0x17, 0x02, 0x1f, 0x19,
+    0x4f, 0x18, 0x02, 0x1f, 0x1a, 0x4e, 0x19, 0x02, 0x20, 0x1a, 0x4d, 0x19, 0x02, 0x20, 0x1b, 0x4c,
+    0x1a, 0x02, 0x21, 0x1c, 0x4a, 0x1b, 0x02, 0x21, 0x1e, 0x48, 0x1d, 0x01, 0x22, 0x42, 0x01, 0x23,
+    0x40, 0x01, 0x24, 0x3e, 0x81, 0x01, 0x25, 0x3c, 0x01, 0x26, 0x3a, 0x01, 0x27, 0x38, 0x01, 0x29,
+    0x35, 0x01, 0x2a, 0x33, 0x01, 0x2b, 0x30, 0x01, 0x2d, 0x2d, 0x01, 0x2f, 0x29, 0x01, 0x2e, 0x2b,
+    0x01, 0x2c, 0x2f, 0x01, 0x2a, 0x33, 0x01, 0x29, 0x35, 0x01, 0x28, 0x37, 0x01, 0x27, 0x39, 0x01,
+    0x26, 0x3b, 0x01, 0x25, 0x3d, 0x01, 0x24, 0x3f, 0x01, 0x23, 0x41, 0x01, 0x22, 0x43, 0x01, 0x21,
+    0x45, 0x81, 0x02, 0x20, 0x1f, 0x47, 0x20, 0x02, 0x1f, 0x1e, 0x4a, 0x1e, 0x02, 0x1f, 0x1c, 0x4c,
+    0x1c, 0x02, 0x1e, 0x1c, 0x4d, 0x1c, 0x02, 0x1e, 0x1b, 0x4e, 0x1b, 0x02, 0x1d, 0x1b, 0x4f, 0x1b,
+    0x02, 0x1d, 0x1a, 0x50, 0x1a, 0x02, 0x1d, 0x1a, 0x50, 0x1b, 0x02, 0x1c, 0x1a, 0x51, 0x1a, 0x02,
+    0x1c, 0x19, 0x52, 0x19, 0x02, 0x1c, 0x19, 0x52, 0x1a, 0x02, 0x1b, 0x1a, 0x53, 0x19, 0x02, 0x1b,
+    0x19, 0x53, 0x19, 0x02, 0x1b, 0x19, 0x53, 0x1a, 0x02, 0x1a, 0x1a, 0x54, 0x19, 0x02, 0x1a, 0x19,
+    0x54, 0x19, 0x82, 0x02, 0x1a, 0x19, 0x55, 0x18, 0x02, 0x1a, 0x18, 0x55, 0x19, 0x02, 0x19, 0x19,
+    0x55, 0x19, 0x8b, 0x02, 0x19, 0x1a, 0x55, 0x19, 0x02, 0x19, 0x1a, 0x54, 0x1a, 0x81, 0x02, 0x19,
+    0x1a, 0x54, 0x19, 0x02, 0x1a, 0x19, 0x54, 0x19, 0x02, 0x1a, 0x1a, 0x54, 0x19, 0x02, 0x1a, 0x1a,
+    0x53, 0x1a, 0x81, 0x02, 0x1a, 0x1b, 0x53, 0x1a, 0x02, 0x1a, 0x1b, 0x52, 0x1b, 0x02, 0x1b, 0x1b,
+    0x52, 0x1a, 0x02, 0x1b, 0x1b, 0x51, 0x1b, 0x02, 0x1b, 0x1c, 0x51, 0x1b, 0x02, 0x1b, 0x1d, 0x50,
+    0x1c, 0x02, 0x1c, 0x1c, 0x4f, 0x1c, 0x02, 0x1c, 0x1d, 0x4e, 0x1d, 0x02, 0x1c, 0x1e, 0x4d, 0x1e,
+    0x02, 0x1d, 0x1f, 0x4c, 0x1e, 0x02, 0x1d, 0x20, 0x4a, 0x20, 0x02, 0x1d, 0x23, 0x48, 0x21, 0x01,
+    0x1e, 0x4b, 0x81, 0x01, 0x1f, 0x49, 0x81, 0x01, 0x20, 0x47, 0x01, 0x21, 0x45, 0x81, 0x01, 0x22,
+    0x43, 0x01, 0x23, 0x41, 0x81, 0x01, 0x24, 0x3f, 0x01, 0x25, 0x3d, 0x01, 0x26, 0x3b, 0x01, 0x27,
+    0x39, 0x01, 0x28, 0x37, 0x01, 0x29, 0x35, 0x01, 0x2a, 0x33, 0x01, 0x2c, 0x30, 0x01, 0x2d, 0x2d,
+    0x01, 0x2f, 0x2a, 0x01, 0x31, 0x26, 0x01, 0x33, 0x22, 0x01, 0x35, 0x1e, 0x01, 0x38, 0x18, 0x01,
+    0x3d, 0x0e, 0x00, 0xa4,
+};
+
+const uint8_t *const NumberSpanImages[] = {
+    NumberSpanImage0, NumberSpanImage1, NumberSpanImage2, NumberSpanImage3, NumberSpanImage4, NumberSpanImage5, NumberSpanImage6, NumberSpanImage7, NumberSpanImage8
+};
+#define NumberSpanImageCount 9
+
+const uint8_t LogoSpanImage[] = {
+    0x00, 0x9d, 0x01, 0x55, 0x07, 0x01, 0x4e, 0x10, 0x01, 0x46, 0x19, 0x01, 0x3f, 0x21, 0x01, 0x38,
+    0x28, 0x01, 0x31, 0x30, 0x02, 0x2a, 0x2b, 0x5a, 0x07, 0x02, 0x23, 0x2b, 0x5b, 0x06, 0x02, 0x1c,
+    0x2b, 0x5b, 0x06, 0x03, 0x15, 0x2b, 0x5b, 0x06, 0x70, 0x05, 0x03, 0x13, 0x26, 0x5b, 0x06, 0x69,
+    0x0e, 0x03, 0x12, 0x20, 0x5b, 0x06, 0x62, 0x16, 0x02, 0x11, 0x1a, 0x5b, 0x1e, 0x02, 0x10, 0x14,
+    0x54, 0x25, 0x02, 0x0f, 0x0d, 0x4c, 0x2d, 0x03, 0x0f, 0x07, 0x45, 0x2c, 0x72, 0x07, 0x03, 0x0f,
+    0x06, 0x3e, 0x2c, 0x74, 0x05, 0x03, 0x0e, 0x06, 0x37, 0x2c, 0x74, 0x05, 0x03, 0x0e, 0x06, 0x30,
+    0x2c, 0x74, 0x05, 0x03, 0x0e, 0x06, 0x2d, 0x28, 0x74, 0x05, 0x03, 0x0e, 0x06, 0x2b, 0x22, 0x74,
+    0x05, 0x03, 0x0e, 0x06, 0x2a, 0x1c, 0x74, 0x05, 0x03, 0x0e, 0x06, 0x29, 0x16, 0x74, 0x05, 0x04,
+    0x0e, 0x06, 0x29, 0x0f, 0x68, 0x04, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x28, 0x09, 0x61, 0x0c, 0x74,
+    0x05, 0x04, 0x0e, 0x06, 0x28, 0x06, 0x5a, 0x13, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x53,
+    0x1b, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x4c, 0x22, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27,
+    0x06, 0x44, 0x2a, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x3d, 0x31, 0x74, 0x05, 0x05, 0x0e,
+    0x06, 0x27, 0x06, 0x37, 0x2b, 0x68, 0x06, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x36, 0x25,
+    0x68, 0x06, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x35, 0x1e, 0x68, 0x06, 0x74, 0x05, 0x05,
+    0x0e, 0x06, 0x27, 0x06, 0x34, 0x18, 0x68, 0x06, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34,
+    0x11, 0x68, 0x06, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x0a, 0x68, 0x06, 0x74, 0x05,
+    0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x68, 0x06, 0x74, 0x05, 0xbc, 0x05, 0x0e, 0x06, 0x27,
+    0x06, 0x34, 0x06, 0x68, 0x05, 0x74, 0x05, 0x81, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x68,
+    0x06, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x68, 0x05, 0x74, 0x05, 0x05, 0x0e,
+    0x06, 0x27, 0x06, 0x34, 0x06, 0x68, 0x06, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06,
+    0x68, 0x05, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x68, 0x06, 0x74, 0x05, 0x81,
+    0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x67, 0x06, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06,
+    0x34, 0x06, 0x60, 0x0d, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x59, 0x14, 0x74,
+    0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x52, 0x1b, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27,
+    0x06, 0x34, 0x06, 0x4a, 0x23, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x43, 0x29,
+    0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x3c, 0x2c, 0x74, 0x05, 0x04, 0x0e, 0x06,
+    0x27, 0x06, 0x34, 0x2d, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x26, 0x74, 0x05, 0x04,
+    0x0e, 0x06, 0x27, 0x06, 0x34, 0x1e, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x17, 0x74,
+    0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x35, 0x0f, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x35,
+    0x08, 0x74, 0x05, 0x03, 0x0e, 0x06, 0x27, 0x06, 0x74, 0x05, 0x83, 0x04, 0x0e, 0x06, 0x27, 0x06,
+    0x5e, 0x0b, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x57, 0x14, 0x74, 0x05, 0x04, 0x0e, 0x06,
+    0x27, 0x06, 0x50, 0x1b, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x48, 0x24, 0x74, 0x05, 0x04,
+    0x0e, 0x06, 0x27, 0x06, 0x41, 0x2c, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x3c, 0x31, 0x74,
+    0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x39, 0x26, 0x67, 0x06, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27,
+    0x06, 0x38, 0x1f, 0x67, 0x06, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x37, 0x19, 0x68, 0x05,
+    0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x36, 0x13, 0x68, 0x05, 0x74, 0x05, 0x05, 0x0e, 0x06,
+    0x27, 0x06, 0x36, 0x0c, 0x68, 0x05, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x35, 0x07, 0x68,
+    0x05, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x35, 0x06, 0x68, 0x05, 0x74, 0x05, 0x05, 0x0e,
+    0x06, 0x27, 0x06, 0x34, 0x06, 0x68, 0x05, 0x74, 0x05, 0x8d, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34,
+    0x06, 0x67, 0x06, 0x74, 0x05, 0x81, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x66, 0x06, 0x74,
+    0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x63, 0x09, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27,
+    0x06, 0x34, 0x06, 0x5b, 0x10, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x54, 0x17,
+    0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x06, 0x4d, 0x1d, 0x74, 0x05, 0x05, 0x0e, 0x06,
+    0x27, 0x06, 0x34, 0x06, 0x46, 0x23, 0x74, 0x05, 0x05, 0x0e, 0x06, 0x27, 0x06, 0x34, 0x07, 0x3f,
+    0x28, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x35, 0x2e, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27,
+    0x06, 0x35, 0x27, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x36, 0x1f, 0x74, 0x05, 0x04, 0x0e,
+    0x06, 0x27, 0x06, 0x36, 0x18, 0x74, 0x05, 0x04, 0x0e, 0x06, 0x27, 0x06, 0x37, 0x10, 0x74, 0x05,
+    0x04, 0x0e, 0x06, 0x25, 0x08, 0x39, 0x07, 0x74, 0x05, 0x03, 0x0e, 0x06, 0x1e, 0x0f, 0x73, 0x06,
+    0x03, 0x0e, 0x07, 0x17, 0x16, 0x72, 0x07, 0x02, 0x0e, 0x1f, 0x6b, 0x0d, 0x02, 0x0f, 0x1e, 0x64,
+    0x14, 0x02, 0x0f, 0x1e, 0x5d, 0x1a, 0x03, 0x10, 0x16, 0x27, 0x06, 0x56, 0x20, 0x03, 0x11, 0x0e,
+    0x27, 0x06, 0x4f, 0x26, 0x03, 0x13, 0x05, 0x27, 0x06, 0x48, 0x2a, 0x02, 0x27, 0x06, 0x41, 0x2b,
+    0x02, 0x27, 0x06, 0x3a, 0x2b, 0x02, 0x27, 0x07, 0x32, 0x2c, 0x01, 0x27, 0x30, 0x01, 0x28, 0x28,
+    0x01, 0x28, 0x21, 0x01, 0x29, 0x18, 0x01, 0x2a, 0x10, 0x01, 0x2b, 0x08, 0x00, 0x9c,
+};
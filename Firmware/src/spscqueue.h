@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+
+// Lock-free ring buffer for exactly one producer and one consumer, e.g. the
+// ESP-NOW receive callback (Wi-Fi task) handing frames to loop(). push()
+// must only be called from the producer and pop() only from the consumer.
+// Size must be a power of 2.
+template <typename T, uint32_t Size>
+class SpscQueue {
+    static_assert(Size > 0 && (Size & (Size - 1)) == 0, "Size must be a power of 2");
+
+public:
+    SpscQueue() : head(0), tail(0) {
+    }
+
+    // Returns false and drops the item if the queue is full
+    bool push(const T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == Size) {
+            return false;
+        }
+
+        items[h & (Size - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = items[t & (Size - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T items[Size];
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+};
@@ -1,69 +1,122 @@
+#include <assert.h>
 #include <M5StickCPlus.h>
-#include <Preferences.h>
 #include <WiFi.h>
 #include <esp_now.h>
-#include <FastLED.h>
 #include "CRC.h"
 #include "system.h"
+#include "txscheduler.h"
+#include "linkstats.h"
+#include "spscqueue.h"
+#include "serialparser.h"
+#include "ackwindow.h"
+#include "tasks.h"
+#include "profiler.h"
+#include "ledoutput.h"
+#include "settings.h"
 #include "esp_private/wifi.h"
 
-#define EXTERNAL_LED_PIN 32
-#define EXTERNAL_LED_NUM 4
-
-Preferences preferences;
-CRGB leds[EXTERNAL_LED_NUM];
-
-#define PREF_LIB "pref_lib"
-#define PREF_MODE_NAME "p_mode"
-#define PREF_AUDIO_NAME "p_audio"
-#define PREF_BRIGHTNESS_NAME "p_brignes"
-#define MESSAGE_INTERVAL 33
 #define AUTOSHUTDOWN_TIME 15000
 
 #define MSG_TEST 0x01
 #define MSG_STATUS 0x02
 #define MSG_PING 0x03
 #define MSG_PONG 0x04
+#define MSG_TX_CONFIG 0x05
+#define MSG_STATUS_PACKED 0x06
+#define MSG_LINK_STATS 0x07
+#define MSG_BINARY_MODE 0x08
+#define MSG_ACK 0x09
+#define MSG_STATS 0x0A
+#define MSG_LED_LAYOUT 0x0B
+
+// Set on the type of radio frames carrying a 16 bit sequence number
+// right after the type byte
+#define MSG_FLAG_SEQUENCE 0x40
 
 #define MSG_OK 0x00
 #define MSG_ERROR 0xFF
 
+#define COMMAND_QUEUE_SIZE 8
+
+#define RADIO_QUEUE_SIZE 8
+#define RADIO_FRAME_MAX_LEN 64
+
+// Sequenced header, camera count, four cameras per byte, CRC
+#define STATUS_FRAME_MAX_LEN (4 + 1 + (MAX_CAMERA_COUNT + 3) / 4 + 2)
+#define TEST_FRAME_LEN (4 + 1 + 2)
+
+// Length, type, count, 22 bytes per link, CRC
+#define LINK_STATS_REPLY_MAX_LEN (5 + LINK_MAX_COUNT * 22)
+// Length, type, count, 20 bytes per profiled section, CRC
+#define STATS_REPLY_LEN (5 + PROFILE_SECTION_COUNT * 20)
+
+#define RADIO_OK 0
+#define RADIO_ERROR_CRC 1
+
+static_assert(TX_HEARTBEAT_INTERVAL_MAX * 3 < LED_LINK_LOSS_TIME, "receivers must survive lost heartbeats");
+
+// Frame handed from the ESP-NOW receive callback to loop(), XOR decoded
+// and CRC checked
+typedef struct {
+    uint8_t address[ESP_NOW_ETH_ALEN];
+    uint8_t error;
+    uint8_t len;
+    uint32_t receivedTime;
+    uint8_t data[RADIO_FRAME_MAX_LEN];
+} RadioFrame;
+
 const uint8_t broadcastAddress[ESP_NOW_ETH_ALEN] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
 
-uint8_t mode = MODE_CAMERA_1;
-String errorMsg = "";
+// Persisted values, changed through SettingsStore
+const Settings& settings = SettingsStore::get();
+const char *errorMsg = "";
+char errorMsgBuf[32];
 
 bool isTimeToSendTestMessage = false;
 uint8_t testMessageFlag = 0;
 
-uint8_t brightness = 2;
-const uint8_t brightnessScales[] = {40, 82, 177, 219, 255};
+const uint8_t brightnessScales[BRIGHTNESS_LEVEL_COUNT] = {40, 82, 177, 219, 255};
 
 bool isTestMode = false;
-bool isAudioEnabled = true;
 uint32_t testModeInitiateTime = 0;
 uint32_t lastTestBeepTime = 0;
 uint32_t lastReceivedTime = 0;
-uint32_t lastMessageSentTime = 0;
+
+TxScheduler txScheduler;
+uint16_t txSequence = 0;
+uint8_t lastSentType = 0;
+
+LinkTable linkTable;
+
+SerialParser serialParser;
+SerialTxQueue serialTxQueue;
+AckWindow ackWindow;
+uint8_t ackEncoding = SERIAL_ENCODING_HEX;
+LoopStats loopStats = { 0, 0, 0, 0 };
+
+typedef struct {
+    uint8_t command;
+    uint8_t value;
+} Command;
+
+QueueHandle_t commandQueue = NULL;
+QueueHandle_t snapshotQueue = NULL;
+TallySnapshot publishedSnapshot;   // filled here, copied into snapshotQueue
+
+SpscQueue<RadioFrame, RADIO_QUEUE_SIZE> radioQueue;
+
+void publishSnapshot();
+std::atomic<uint32_t> radioFramesDropped(0);
 
 uint32_t lastAlertBeepTime = 0;
 int8_t alertCountRemaining = 0;
 
-uint32_t lastLedUpdateTime = 0;
-
-uint8_t cameraStatus[8] = {
-    CAMERA_STATUS_STANDBY,
-    CAMERA_STATUS_STANDBY,
-    CAMERA_STATUS_STANDBY, 
-    CAMERA_STATUS_STANDBY
-#if CAMERA_COUNT > 4
-    ,
-    CAMERA_STATUS_STANDBY,
-    CAMERA_STATUS_STANDBY,
-    CAMERA_STATUS_STANDBY,
-    CAMERA_STATUS_STANDBY
-#endif
-};
+LedEffects ledEffects;
+uint32_t nextLedFrameTime = 0;
+uint8_t lastLedStatus = 0xff;
+
+uint8_t cameraCount = DEFAULT_CAMERA_COUNT;
+uint8_t cameraStatus[MAX_CAMERA_COUNT] = { CAMERA_STATUS_STANDBY };
 
 esp_err_t registerPeer(const uint8_t *address) {
     esp_now_peer_info_t peerData = {
@@ -78,119 +131,153 @@ esp_err_t registerPeer(const uint8_t *address) {
     return esp_now_add_peer(&peerData);
 }
 
-esp_err_t broadcastSend(uint8_t *buf) {
-    uint8_t len = buf[0];
+esp_err_t broadcastSend(uint8_t *buf, uint8_t len, size_t capacity) {
+    assert(len <= capacity);
+    (void)capacity;
     for (uint8_t i = 0; i < len; ++i) {
         buf[i] = buf[i] ^ PACKET_XOR_KEY;
     }
     return esp_now_send(broadcastAddress, buf, len);
 }
 
-uint8_t* hexStringToBytes(const char* string, size_t *len) {
-    if (string == NULL) {
-       return NULL;
+// Completes a sequenced radio frame whose payload was written from buf[4].
+// A repeat of the previous frame within a burst keeps its sequence number
+// so receivers can tell it from a new one. Returns the frame length.
+uint8_t sealSequencedFrame(uint8_t *buf, uint8_t type, uint8_t payloadLen, bool isRepeat) {
+    if (!isRepeat || type != lastSentType) {
+        txSequence++;
     }
+    lastSentType = type;
 
-    size_t slength = strlen(string);
-    if ((slength % 2) != 0) {// must be even
-       return NULL;
-    }
-
-    size_t dlength = slength / 2;
-    *len = dlength;
-
-    uint8_t* data = new uint8_t[dlength];
-    memset(data, 0, dlength);
+    uint8_t len = payloadLen + 6;
+    buf[0] = len;
+    buf[1] = type | MSG_FLAG_SEQUENCE;
+    buf[2] = txSequence & 0xff;
+    buf[3] = txSequence >> 8;
 
-    size_t index = 0;
-    while (index < slength) {
-        char c = string[index];
-        int value = 0;
-        if (c >= '0' && c <= '9')
-          value = (c - '0');
-        else if (c >= 'A' && c <= 'F') 
-          value = (10 + (c - 'A'));
-        else if (c >= 'a' && c <= 'f')
-          value = (10 + (c - 'a'));
-        else {
-          delete [] data;
-          return NULL;
-        }
+    uint16_t crc = crc16(buf, len - 2);
+    memcpy(&buf[len - 2], &crc, 2);
+    return len;
+}
 
-        data[(index/2)] += value << (((index + 1) % 2) * 4);
-        index++;
+// MSG_STATUS carries one byte per camera, MSG_STATUS_PACKED packs four
+// cameras into each byte (2 bits each, camera 1 in the lowest bits)
+size_t statusFrameLength(uint8_t type, uint8_t count) {
+    if (type == MSG_STATUS_PACKED) {
+        return (count + 3) / 4 + 5;
     }
-
-    return data;
+    return count + 5;
 }
 
-char *bytesToHexString(const uint8_t *bin, uint32_t binsz) {
-    const char hex_str[] = "0123456789abcdef";
-    uint32_t i;
+// Applies a validated status frame to cameraStatus, returns true if any
+// camera or the camera count changed
+bool decodeStatus(uint8_t type, const uint8_t *data) {
+    uint8_t count = min(MAX_CAMERA_COUNT, data[2]);
+    bool isChanged = count != cameraCount;
 
-    if (!binsz) {
-        return NULL;
-    }
-    char *result = new char[binsz * 2 + 2];
-    if (result == NULL) {
-        return NULL;
+    for (uint8_t i = 0; i < count; ++i) {
+        uint8_t status;
+        if (type == MSG_STATUS_PACKED) {
+            status = (data[3 + i / 4] >> ((i % 4) * 2)) & 0x03;
+        } else {
+            status = data[3 + i];
+        }
+        isChanged |= cameraStatus[i] != status;
+        cameraStatus[i] = status;
     }
-    result[binsz * 2] = '\n';
-    result[binsz * 2 + 1] = 0;
 
-    for (i = 0; i < binsz; i++) {
-        result[i * 2 + 0] = hex_str[(bin[i] >> 4) & 0x0F];
-        result[i * 2 + 1] = hex_str[(bin[i]     ) & 0x0F];
+    for (uint8_t i = count; i < cameraCount; ++i) {
+        cameraStatus[i] = CAMERA_STATUS_STANDBY;
     }
-    return result;
+
+    cameraCount = count;
+    return isChanged;
 }
 
+// Runs in the Wi-Fi task. It only fills a queue slot, the tally state is
+// changed by processRadioFrame() on the loop() side.
 void onDataReceived(const uint8_t *address, const uint8_t *src_data, int len) {
-    uint8_t data[64] = {0};
-    if (len >= 64) {
+    RadioFrame frame;
+    if (len < 4 || len >= RADIO_FRAME_MAX_LEN) {
         return;
     }
 
     for (int i = 0; i < len; ++i) {
-        data[i] = src_data[i] ^ PACKET_XOR_KEY;
+        frame.data[i] = src_data[i] ^ PACKET_XOR_KEY;
     }
 
-    if (mode == MODE_HOST || len < 4 || data[0] != len) {
+    if (frame.data[0] != len) {
         return;
     }
 
-    uint16_t crc = crc16(data, len - 2);
-    if (*(uint16_t *)&data[len - 2] != crc) {
+    uint16_t crc = crc16(frame.data, len - 2);
+    frame.error = memcmp(&frame.data[len - 2], &crc, 2) == 0 ? RADIO_OK : RADIO_ERROR_CRC;
+    frame.len = len;
+    frame.receivedTime = millis();
+    memcpy(frame.address, address, ESP_NOW_ETH_ALEN);
+
+    if (!radioQueue.push(frame)) {
+        radioFramesDropped++;
+    }
+    Tasks::notifyTally();
+}
+
+void processRadioFrame(RadioFrame& frame) {
+    PROFILE_SCOPE(PROFILE_RADIO);
+
+    uint8_t *data = frame.data;
+    uint8_t len = frame.len;
+
+    if (settings.mode == MODE_HOST) {
+        return;
+    }
+
+    if (frame.error == RADIO_ERROR_CRC) {
         errorMsg = "CRC failed";
         return;
     }
 
-    uint16_t type = data[1];
-    if (type == MSG_TEST) {
-        if (len != 5) {
+    lastReceivedTime = frame.receivedTime;
+
+    uint8_t type = data[1];
+    if ((type & MSG_FLAG_SEQUENCE) != 0) {
+        if (len < 6) {
             errorMsg = "Invalid len";
             return;
         }
-        if (mode == MODE_HOST) {
+
+        uint16_t sequence = data[2] | (data[3] << 8);
+        if (!linkTable.accept(frame.address, sequence, frame.receivedTime)) {
+            return;
+        }
+
+        // Strip the sequence number, the rest decodes like an unsequenced frame
+        len -= 2;
+        memmove(&data[2], &data[4], len - 2);
+        data[0] = len;
+        type &= ~MSG_FLAG_SEQUENCE;
+    }
+
+    if (type == MSG_TEST) {
+        if (len != 5) {
+            errorMsg = "Invalid len";
             return;
         }
-        if ((data[2] & (1 << (mode - 1))) != 0) {
-            testModeInitiateTime = millis();
+        // The target bitmask only addresses camera 1-8, 0xff reaches everyone
+        if (data[2] == 0xff || (settings.mode <= 8 && (data[2] & (1 << (settings.mode - 1))) != 0)) {
+            testModeInitiateTime = frame.receivedTime;
             isTestMode = true;
         }
-    } else if (type == MSG_STATUS) {
-        if (len != data[2] + 5) {
+    } else if (type == MSG_STATUS || type == MSG_STATUS_PACKED) {
+        if (len != statusFrameLength(type, data[2])) {
             errorMsg = "Invalid status";
             return;
         }
 
         uint8_t lastStatus = System::getCurrentCameraStatus();
-        uint8_t count = min(CAMERA_COUNT, data[2]);
-        for (uint8_t i = 0; i < count; ++i) {
-            cameraStatus[i] = data[3 + i];
-        }
+        decodeStatus(type, data);
 
-        if (isAudioEnabled) {
+        if (settings.isAudioEnabled) {
             if (lastStatus != CAMERA_STATUS_PROGRAM && System::getCurrentCameraStatus() == CAMERA_STATUS_PROGRAM) {
                 alertCountRemaining = 2;
             } else if (lastStatus == CAMERA_STATUS_PROGRAM && System::getCurrentCameraStatus() != CAMERA_STATUS_PROGRAM) {
@@ -198,40 +285,31 @@ void onDataReceived(const uint8_t *address, const uint8_t *src_data, int len) {
             } 
         }
     }
-
-    lastReceivedTime = millis();
 }
 
 void System::begin() {
+    commandQueue = xQueueCreate(COMMAND_QUEUE_SIZE, sizeof(Command));
+    snapshotQueue = xQueueCreate(1, sizeof(TallySnapshot));
+
     M5.begin(true, true, false);
     M5.Beep.setBeep(2000, 50);
     Serial.begin(115200);
-    Serial.setTimeout(100);
     Serial.flush();
     delay(100);
 
     pinMode(26, OUTPUT);
     digitalWrite(26, HIGH);
 
-    FastLED.addLeds<NEOPIXEL, EXTERNAL_LED_PIN>(leds, EXTERNAL_LED_NUM);
+    LedOutput::begin();
 
     WiFi.mode(WIFI_MODE_STA);
     esp_wifi_internal_set_fix_rate(WIFI_IF_STA, true, WIFI_PHY_RATE_LORA_250K);
     esp_wifi_set_protocol(WIFI_IF_STA, WIFI_PROTOCOL_LR);
 
-    preferences.begin(PREF_LIB);
-
-    if (preferences.isKey(PREF_MODE_NAME)) {
-        mode = preferences.getUChar(PREF_MODE_NAME, MODE_CAMERA_1);
-    }
+    SettingsStore::begin();
 
-    if (preferences.isKey(PREF_AUDIO_NAME)) {
-        isAudioEnabled = preferences.getBool(PREF_AUDIO_NAME, true);
-    }
-
-    if (preferences.isKey(PREF_BRIGHTNESS_NAME)) {
-        brightness = preferences.getUChar(PREF_BRIGHTNESS_NAME, 2);
-    }
+    // The GUI may start drawing before the tally task ran once
+    publishSnapshot();
 
     if (esp_now_init() != ESP_OK) {
         errorMsg = "E-ESP-NOW";
@@ -240,26 +318,93 @@ void System::begin() {
 
     esp_now_register_recv_cb(onDataReceived);
 
-    if (mode == MODE_HOST) {
+    if (settings.mode == MODE_HOST) {
         registerPeer(broadcastAddress);
     }
 }
 
 uint8_t System::getMode() {
-    return mode;
+    return settings.mode;
 }
 
 void System::setMode(uint8_t val) {
-    mode = val;
-    preferences.putUChar(PREF_MODE_NAME, mode);
+    SettingsStore::setMode(val);
 }
 
-const String& System::getErrorMsg() {
+const char *System::getErrorMsg() {
     return errorMsg;
 }
 
-void processCommands(const uint8_t *data, size_t len) {
+// Commands changing the transmitter state, shared by the plain and the
+// pipelined path. data[2] is the first payload byte and len the length of
+// the unsequenced frame. Returns false if the command was rejected.
+bool executeCommand(uint8_t type, const uint8_t *data, size_t len, bool isLatest) {
+    if (type == MSG_TEST) {
+        if (len != 5 || settings.mode != MODE_HOST) {
+            return false;
+        }
+        System::sendTestMessage(data[2]);
+    } else if (type == MSG_STATUS || type == MSG_STATUS_PACKED) {
+        if (len != statusFrameLength(type, data[2]) || settings.mode != MODE_HOST) {
+            return false;
+        }
+        // A retransmitted status must not roll back a newer one
+        if (isLatest && decodeStatus(type, data)) {
+            txScheduler.trigger(micros());
+        }
+    } else if (type == MSG_TX_CONFIG) {
+        if (len != 7) {
+            return false;
+        }
+        // Receivers must hear from the host well within LED_LINK_LOSS_TIME
+        uint16_t heartbeatInterval = data[3] | (data[4] << 8);
+        if (heartbeatInterval < TX_BURST_INTERVAL || heartbeatInterval > TX_HEARTBEAT_INTERVAL_MAX) {
+            return false;
+        }
+        txScheduler.setBurstCount(data[2]);
+        txScheduler.setHeartbeatInterval(heartbeatInterval);
+    } else if (type == MSG_LED_LAYOUT) {
+        // [count][segment count] then per segment [start][length][role]
+        if (len < 6 || data[3] > LED_SEGMENT_MAX || len != 6 + data[3] * 3u) {
+            return false;
+        }
+        LedLayout layout;
+        memset(&layout, 0, sizeof(layout));
+        layout.count = data[2];
+        layout.segmentCount = data[3];
+        memcpy(layout.segments, &data[4], layout.segmentCount * 3);
+        if (!System::setLedLayout(layout)) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+void sendAck() {
+    uint8_t buf[10];
+    uint16_t cumulative = ackWindow.getCumulative();
+    uint32_t selective = ackWindow.getSelective();
+
+    buf[0] = 10;
+    buf[1] = MSG_ACK;
+    memcpy(&buf[2], &cumulative, 2);
+    memcpy(&buf[4], &selective, 4);
+
+    uint16_t crc = crc16(buf, 8);
+    memcpy(&buf[8], &crc, 2);
+    serialTxQueue.writeFrame(buf, 10, ackEncoding);
+}
+
+// Replies go out in the encoding the command came in, so the host decides
+// between hex and binary framing per frame
+void processCommands(const uint8_t *data, size_t len, uint8_t encoding) {
+    PROFILE_SCOPE(PROFILE_COMMANDS);
     uint8_t buf[128] = {0};
+    static_assert(LINK_STATS_REPLY_MAX_LEN <= sizeof(buf), "link stats reply must fit the buffer");
+    static_assert(STATS_REPLY_LEN <= sizeof(buf), "stats reply must fit the buffer");
 
     if (len < 4 || data[0] != len) {
         return;
@@ -267,76 +412,200 @@ void processCommands(const uint8_t *data, size_t len) {
 
     uint16_t crc = crc16(data, len - 2);
     if (*(uint16_t *)&data[len - 2] != crc) {
-        char str[64];
-        sprintf(str, "crc %04x:%02x%02x%02x%02x", crc, data[0], data[1], data[2], data[3]);
-        errorMsg = str;
+        snprintf(errorMsgBuf, sizeof(errorMsgBuf), "crc %04x:%02x%02x%02x%02x", crc, data[0], data[1], data[2], data[3]);
+        errorMsg = errorMsgBuf;
         return;
     }
 
-    uint16_t type = data[1];
-    if (type == MSG_TEST) {
+    uint8_t type = data[1];
+    if ((type & MSG_FLAG_SEQUENCE) != 0) {
+        // Pipelined command: [len][type | MSG_FLAG_SEQUENCE][id lo][id hi][payload][crc].
+        // Instead of a reply per command, one MSG_ACK covering everything
+        // received so far goes out per loop.
+        if (len < 6) {
+            return;
+        }
+
+        uint8_t arrival = ackWindow.receive(data[2] | (data[3] << 8));
+        ackEncoding = encoding;
+        if (arrival == ACK_NEWEST || arrival == ACK_LATE) {
+            // Skipping the ID puts the payload where executeCommand expects it
+            if (!executeCommand(type & ~MSG_FLAG_SEQUENCE, data + 2, len - 2, arrival == ACK_NEWEST)) {
+                errorMsg = "Invalid command";
+            }
+        }
+        return;
+    }
+
+    if (type == MSG_LED_LAYOUT && len == 4) {
+        // Without a payload it reads the layout back, in the same format
+        buf[1] = MSG_LED_LAYOUT;
+        buf[2] = settings.ledLayout.count;
+        buf[3] = settings.ledLayout.segmentCount;
+        memcpy(&buf[4], settings.ledLayout.segments, settings.ledLayout.segmentCount * 3);
+        buf[0] = 6 + settings.ledLayout.segmentCount * 3;
+    } else if (type == MSG_TEST || type == MSG_STATUS || type == MSG_STATUS_PACKED || type == MSG_TX_CONFIG
+        || type == MSG_LED_LAYOUT) {
         buf[0] = 4;
-        buf[1] = MSG_OK;
+        buf[1] = executeCommand(type, data, len, true) ? MSG_OK : MSG_ERROR;
+    } else if (type == MSG_PING) {
+        // A new host session, its request IDs start over
+        ackWindow.reset();
 
-        if (len != 5) {
+        buf[0] = 4;
+        buf[1] = MSG_PONG;
+
+        if (len != 4) {
             buf[1] = MSG_ERROR;
-        } else {
-            System::sendTestMessage(data[2]);
         }
-    } else if (type == MSG_STATUS) {
+    } else if (type == MSG_BINARY_MODE) {
+        // Capability check, the host switches to COBS framing on this reply
         buf[0] = 4;
-        buf[1] = MSG_OK;
+        buf[1] = MSG_BINARY_MODE;
 
-        if (len != data[2] + 5) {
+        if (len != 4) {
             buf[1] = MSG_ERROR;
-        } else {
-            uint8_t count = min(CAMERA_COUNT, data[2]);
+        }
+    } else if (type == MSG_LINK_STATS) {
+        // Reply: [count] then per link [address:6][received:4][lost:4][duplicate:4][stale:4]
+        buf[0] = 4;
+        buf[1] = MSG_ERROR;
+
+        if (len == 4) {
+            uint8_t count = linkTable.getCount();
+            buf[1] = MSG_LINK_STATS;
+            buf[2] = count;
             for (uint8_t i = 0; i < count; ++i) {
-                cameraStatus[i] = data[3 + i];
+                const LinkStats& link = linkTable.get(i);
+                uint8_t *dst = &buf[3 + i * 22];
+                memcpy(&dst[0], link.address, 6);
+                memcpy(&dst[6], &link.received, 4);
+                memcpy(&dst[10], &link.lost, 4);
+                memcpy(&dst[14], &link.duplicate, 4);
+                memcpy(&dst[18], &link.stale, 4);
             }
+            buf[0] = 5 + count * 22;
         }
-    } else if (type == MSG_PING) {
+    } else if (type == MSG_STATS) {
+        // Reply: [count] then per profiled section [samples:4][min:4][avg:4][max:4][p99:4], times in us
         buf[0] = 4;
-        buf[1] = MSG_PONG;
-
-        if (len != 4) {
-            buf[1] = MSG_ERROR;
+        buf[1] = MSG_ERROR;
+
+        if (len == 4) {
+            buf[1] = MSG_STATS;
+            buf[2] = PROFILE_SECTION_COUNT;
+            for (uint8_t i = 0; i < PROFILE_SECTION_COUNT; ++i) {
+                ProfileResult result;
+                Profiler::getResult(i, result);
+                uint8_t *dst = &buf[3 + i * 20];
+                memcpy(&dst[0], &result.count, 4);
+                memcpy(&dst[4], &result.minTime, 4);
+                memcpy(&dst[8], &result.avgTime, 4);
+                memcpy(&dst[12], &result.maxTime, 4);
+                memcpy(&dst[16], &result.p99Time, 4);
+            }
+            buf[0] = STATS_REPLY_LEN;
         }
-    } 
+    } else {
+        buf[0] = 4;
+        buf[1] = MSG_ERROR;
+    }
 
     crc = crc16(buf, buf[0] - 2);
     memcpy(&buf[buf[0] - 2], &crc, 2);
-    const char *hexData = bytesToHexString(buf, buf[0]);
-    if (hexData != NULL) {
-        delay(20);
-        Serial.write(hexData);
-        delete [] hexData;
+    serialTxQueue.writeFrame(buf, buf[0], encoding);
+}
+
+void processCommand(const Command& command) {
+    switch (command.command) {
+    case COMMAND_SET_MODE:
+        System::setMode(command.value);
+        break;
+    case COMMAND_SET_AUDIO:
+        System::setIsAudioEnabled(command.value != 0);
+        break;
+    case COMMAND_SET_BRIGHTNESS:
+        System::setBrightness(command.value);
+        break;
+    case COMMAND_SEND_TEST:
+        System::sendTestMessage(command.value);
+        break;
+    case COMMAND_POWER_OFF:
+        System::powerOff();
+        break;
     }
 }
 
+void publishSnapshot() {
+    publishedSnapshot.mode = settings.mode;
+    publishedSnapshot.currentStatus = System::getCurrentCameraStatus();
+    publishedSnapshot.isTestMode = System::isInTestMode();
+    publishedSnapshot.cameraCount = cameraCount;
+    memcpy(publishedSnapshot.cameraStatus, cameraStatus, sizeof(cameraStatus));
+    strncpy(publishedSnapshot.errorMsg, errorMsg, sizeof(publishedSnapshot.errorMsg) - 1);
+    publishedSnapshot.isAudioEnabled = settings.isAudioEnabled;
+    publishedSnapshot.brightness = settings.brightness;
+    publishedSnapshot.txStats = txScheduler.getStats();
+    publishedSnapshot.loopStats = loopStats;
+
+    const LinkStats *link = linkTable.getLatest();
+    publishedSnapshot.hasLink = link != NULL;
+    if (link != NULL) {
+        publishedSnapshot.latestLink = *link;
+    }
+    publishedSnapshot.radioFramesDropped = radioFramesDropped.load();
+    publishedSnapshot.ledStats = LedOutput::getStats();
+    publishedSnapshot.ledEffectStats = ledEffects.getStats();
+    publishedSnapshot.ledLayout = settings.ledLayout;
+    publishedSnapshot.settingsStats = SettingsStore::getStats();
+
+    xQueueOverwrite(snapshotQueue, &publishedSnapshot);
+}
+
+void System::postCommand(uint8_t command, uint8_t value) {
+    Command item = { command, value };
+    xQueueSend(commandQueue, &item, 0);
+}
+
+void System::getSnapshot(TallySnapshot& out) {
+    xQueuePeek(snapshotQueue, &out, 0);
+}
+
 void System::update(uint32_t ms) {
-    if (mode == MODE_HOST) {
-        if (Serial.available()) {
-            const String& str = Serial.readStringUntil('\n');
-            if (str.length() > 0) {
-                size_t length = 0;
-                const uint8_t *data = hexStringToBytes(str.c_str(), &length);
-                if (data != NULL) {
-                    processCommands(data, length);
-                    delete [] data;
-                }
-            }
+    PROFILE_SCOPE(PROFILE_TALLY_LOOP);
+
+    Command command;
+    while (xQueueReceive(commandQueue, &command, 0) == pdTRUE) {
+        processCommand(command);
+    }
+
+    RadioFrame frame;
+    while (radioQueue.pop(frame)) {
+        processRadioFrame(frame);
+    }
+
+    // Only what is already in the UART RX buffer, never wait for the rest of a line
+    int available = Serial.available();
+    while (available-- > 0) {
+        if (serialParser.feed(Serial.read())) {
+            processCommands(serialParser.getFrame(), serialParser.getLength(), serialParser.getEncoding());
         }
-        
-        if (ms - lastMessageSentTime > MESSAGE_INTERVAL) {
+    }
+    if (ackWindow.takePending()) {
+        sendAck();
+    }
+    serialTxQueue.flush(Serial);
+
+    if (settings.mode == MODE_HOST) {
+        if (txScheduler.isDue(micros())) {
             if (isTimeToSendTestMessage) {
                 System::sendTestMessage(testMessageFlag, true);
                 isTimeToSendTestMessage = false;
             } else {
-                sendStatusMessage();
+                sendStatusMessage(txScheduler.isRepeat());
             }
 
-            lastMessageSentTime = ms;
+            txScheduler.onSent(micros());
         }
     }
 
@@ -357,73 +626,88 @@ void System::update(uint32_t ms) {
         }
     }
 
-    if (ms - lastLedUpdateTime > 30) {
+    uint32_t us = micros();
+    bool isLedFrameDue = (int32_t)(us - nextLedFrameTime) >= 0;
+    auto status = System::getCurrentCameraStatus();
+    // A tally change is rendered right away instead of in the next frame slot
+    if (isLedFrameDue || status != lastLedStatus) {
+        PROFILE_SCOPE(PROFILE_LED_SHOW);
         auto mode = System::getMode();
-        auto status = System::getCurrentCameraStatus();
-
+        lastLedStatus = status;
+
+        // The talent side only ever shows program, the operator side also
+        // preview and the state of the tally itself
+        bool isReceiver = mode != MODE_HOST;
+        bool isProgram = isReceiver && status == CAMERA_STATUS_PROGRAM;
+        // Signed, a frame drained in this update is stamped after ms
+        bool isLinkLost = isReceiver && lastReceivedTime != 0 && (int32_t)(ms - lastReceivedTime) > LED_LINK_LOSS_TIME;
         if (System::isInTestMode()) {
-            leds[0] = leds[1] = leds[2] = leds[3] = CRGB::Yellow;
-            FastLED.show(brightnessScales[brightness]);
+            ledEffects.set(LED_ROLE_OPERATOR, LED_EFFECT_PULSE, CRGB::Yellow, ms);
+        } else if (isLinkLost) {
+            ledEffects.set(LED_ROLE_OPERATOR, LED_EFFECT_BLINK, CRGB::Blue, ms);
+        } else if (isReceiver && status == CAMERA_STATUS_PREVIEW) {
+            ledEffects.set(LED_ROLE_OPERATOR, LED_EFFECT_SOLID, CRGB::Green, ms);
+        } else if (isProgram) {
+            ledEffects.set(LED_ROLE_OPERATOR, LED_EFFECT_SOLID, CRGB::Red, ms);
         } else {
-            if (mode != MODE_HOST) {
-                if (status == CAMERA_STATUS_PREVIEW) {
-                    leds[0] = leds[1] = leds[2] = leds[3] = CRGB::Green;
-                    FastLED.show(brightnessScales[brightness]);
-                } else if (status == CAMERA_STATUS_PROGRAM) {
-                    leds[0] = leds[1] = leds[2] = leds[3] = CRGB::Red;
-                    FastLED.show(brightnessScales[brightness]);
-                } else {
-                    FastLED.clear(true);
-                }
-            } else {
-                FastLED.clear(true);
-            }
+            ledEffects.set(LED_ROLE_OPERATOR, LED_EFFECT_SOLID, CRGB::Black, ms);
         }
 
-        lastLedUpdateTime = ms;
+        if (System::isInTestMode()) {
+            ledEffects.set(LED_ROLE_TALENT, LED_EFFECT_PULSE, CRGB::Yellow, ms);
+        } else {
+            ledEffects.set(LED_ROLE_TALENT, LED_EFFECT_SOLID, isProgram ? CRGB::Red : CRGB::Black, ms);
+        }
+        ledEffects.setBrightness(brightnessScales[settings.brightness]);
+
+        LedFrame frame;
+        frame.layout = settings.ledLayout;
+        ledEffects.render(ms, frame);
+        LedOutput::update(frame, us);
+
+        // Keep a steady rate, but don't try to make up for a long stall. An
+        // early frame starts the next interval from now.
+        nextLedFrameTime = isLedFrameDue ? nextLedFrameTime + LED_FRAME_INTERVAL : us + LED_FRAME_INTERVAL;
+        if ((int32_t)(us - nextLedFrameTime) >= 0) {
+            nextLedFrameTime = us + LED_FRAME_INTERVAL;
+        }
     }
 
 	M5.Beep.update();
+
+    SettingsStore::update(ms);
+
+    publishSnapshot();
 }
 
-void System::sendStatusMessage() {
-    uint8_t buf[16] = { 0 };
+void System::sendStatusMessage(bool isRepeat) {
+    uint8_t buf[STATUS_FRAME_MAX_LEN] = { 0 };
 
-    buf[0] = 5 + CAMERA_COUNT;
-    buf[1] = MSG_STATUS;
-    buf[2] = CAMERA_COUNT;
-    for (uint8_t i = 0; i < CAMERA_COUNT; ++i) {
-        buf[3 + i] = cameraStatus[i];
+    buf[4] = cameraCount;
+    for (uint8_t i = 0; i < cameraCount; ++i) {
+        buf[5 + i / 4] |= (cameraStatus[i] & 0x03) << ((i % 4) * 2);
     }
 
-    uint16_t crc = crc16(buf, CAMERA_COUNT + 3);
-    memcpy(&buf[3 + CAMERA_COUNT], &crc, 2);
-
-    broadcastSend(buf);
+    uint8_t len = sealSequencedFrame(buf, MSG_STATUS_PACKED, 1 + (cameraCount + 3) / 4, isRepeat);
+    broadcastSend(buf, len, sizeof(buf));
 }
 
 void System::sendTestMessage(uint8_t target, bool immediately) {
-    uint8_t buf[] = {
-        5,
-        MSG_TEST,
-        target,
-        0,
-        0
-    };
+    uint8_t buf[TEST_FRAME_LEN] = { 0 };
 
     if (!immediately) {
         isTimeToSendTestMessage = true;
         testMessageFlag = target;
+        txScheduler.trigger(micros());
         return;
     }
 
     testModeInitiateTime = millis();
     isTestMode = true;
 
-    uint16_t crc = crc16(buf, 3);
-    memcpy(&buf[3], &crc, 2);
-
-    broadcastSend(buf);
+    buf[4] = target;
+    uint8_t len = sealSequencedFrame(buf, MSG_TEST, 1, false);
+    broadcastSend(buf, len, sizeof(buf));
 }
 
 bool System::isInTestMode() {
@@ -431,6 +715,9 @@ bool System::isInTestMode() {
 }
 
 void System::powerOff() {
+    if (SettingsStore::getStats().isDirty) {
+        SettingsStore::commit();
+    }
     M5.Axp.PowerOff();
 }
 
@@ -438,27 +725,67 @@ const uint8_t *System::getCameraStatus() {
     return cameraStatus;
 }
 
-const uint8_t System::getCurrentCameraStatus() {
-    if (mode == MODE_HOST) {
+uint8_t System::getCameraCount() {
+    return cameraCount;
+}
+
+const LinkStats *System::getLatestLinkStats() {
+    return linkTable.getLatest();
+}
+
+void System::recordLoopTime(uint32_t us) {
+    loopStats.loops++;
+    loopStats.totalTime += us;
+    loopStats.lastTime = us;
+    if (us > loopStats.maxTime) {
+        loopStats.maxTime = us;
+    }
+}
+
+const LoopStats& System::getLoopStats() {
+    return loopStats;
+}
+
+uint32_t System::getRadioFramesDropped() {
+    return radioFramesDropped.load();
+}
+
+const TxStats& System::getTxStats() {
+    return txScheduler.getStats();
+}
+
+uint8_t System::getCurrentCameraStatus() {
+    if (settings.mode == MODE_HOST) {
         return 0xff;
     }
 
-    return cameraStatus[mode - 1];
+    return cameraStatus[settings.mode - 1];
 }
 
 bool System::getIsAudioEnabled() {
-    return isAudioEnabled;
+    return settings.isAudioEnabled;
 }
 
 void System::setIsAudioEnabled(bool val) {
-    isAudioEnabled = val;
-    preferences.putBool(PREF_AUDIO_NAME, isAudioEnabled);
+    SettingsStore::setIsAudioEnabled(val);
 }
 
 uint8_t System::getBrightness() {
-    return brightness;
+    return settings.brightness;
 }
 
 void System::setBrightness(uint8_t val){
-    brightness = val;
-}
\ No newline at end of file
+    SettingsStore::setBrightness(min(val, BRIGHTNESS_LEVEL_COUNT - 1));
+}
+
+const LedLayout& System::getLedLayout() {
+    return settings.ledLayout;
+}
+
+bool System::setLedLayout(const LedLayout& layout) {
+    if (!LedOutput::isValidLayout(layout)) {
+        return false;
+    }
+    SettingsStore::setLedLayout(layout);
+    return true;
+}
@@ -1,10 +1,19 @@
 #pragma once
 #include <M5StickCPlus.h>
+#include "txscheduler.h"
+#include "linkstats.h"
+#include "ledoutput.h"
+#include "ledeffects.h"
+#include "settings.h"
 
 #define FIRMWARE_VERSION "1.0"
 
-// Hardcoded maximum camera count, either 4 or 8
-#define CAMERA_COUNT 4
+// Upper bound of the runtime camera count, the actual count comes from the
+// host (transmitter) or from the received status frames (receiver)
+#define MAX_CAMERA_COUNT 64
+#define DEFAULT_CAMERA_COUNT 4
+
+#define BRIGHTNESS_LEVEL_COUNT 5
 
 // Single byte XOR key for basic encoding
 #define PACKET_XOR_KEY 0x67
@@ -18,6 +27,7 @@
 #define MODE_CAMERA_6 6
 #define MODE_CAMERA_7 7
 #define MODE_CAMERA_8 8
+#define MODE_CAMERA_MAX MAX_CAMERA_COUNT
 
 #define TEST_MODE_TIME 2000
 
@@ -25,19 +35,61 @@
 #define CAMERA_STATUS_PREVIEW 1
 #define CAMERA_STATUS_PROGRAM 2
 
+typedef struct {
+    uint32_t loops;
+    uint64_t totalTime;     // us
+    uint32_t lastTime;      // us
+    uint32_t maxTime;       // us
+} LoopStats;
+
+// Requests from the GUI task, applied by the tally task in System::update
+#define COMMAND_SET_MODE 0
+#define COMMAND_SET_AUDIO 1
+#define COMMAND_SET_BRIGHTNESS 2
+#define COMMAND_SEND_TEST 3
+#define COMMAND_POWER_OFF 4
+
+// Copy of everything the GUI shows, published by the tally task after
+// each System::update
+typedef struct {
+    uint8_t mode;
+    uint8_t currentStatus;
+    bool isTestMode;
+    uint8_t cameraCount;
+    uint8_t cameraStatus[MAX_CAMERA_COUNT];
+    char errorMsg[32];
+    bool isAudioEnabled;
+    uint8_t brightness;
+    TxStats txStats;
+    LoopStats loopStats;
+    bool hasLink;
+    LinkStats latestLink;
+    uint32_t radioFramesDropped;
+    LedStats ledStats;
+    LedEffectStats ledEffectStats;
+    LedLayout ledLayout;
+    SettingsStats settingsStats;
+} TallySnapshot;
+
 class System {
 public:
     static void begin();
 
     static void update(uint32_t ms);
 
+    // Safe to call from any task
+    static void postCommand(uint8_t command, uint8_t value = 0);
+
+    // Safe to call from any task
+    static void getSnapshot(TallySnapshot& snapshot);
+
     static uint8_t getMode();
 
     static void setMode(uint8_t val);
 
-    static const String& getErrorMsg();
+    static const char *getErrorMsg();
 
-    static void sendStatusMessage();
+    static void sendStatusMessage(bool isRepeat = false);
 
     static void sendTestMessage(uint8_t target = 0xff, bool immediately = false);
 
@@ -47,7 +99,19 @@ public:
 
     static const uint8_t *getCameraStatus();
 
-    static const uint8_t getCurrentCameraStatus();
+    static uint8_t getCameraCount();
+
+    static const TxStats& getTxStats();
+
+    static const LinkStats *getLatestLinkStats();
+
+    static uint32_t getRadioFramesDropped();
+
+    static void recordLoopTime(uint32_t us);
+
+    static const LoopStats& getLoopStats();
+
+    static uint8_t getCurrentCameraStatus();
 
     static bool getIsAudioEnabled();
 
@@ -56,4 +120,9 @@ public:
     static uint8_t getBrightness();
 
     static void setBrightness(uint8_t val);
+
+    static const LedLayout& getLedLayout();
+
+    // Stored in the preferences, returns false for an invalid layout
+    static bool setLedLayout(const LedLayout& layout);
 };
\ No newline at end of file
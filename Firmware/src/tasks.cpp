@@ -0,0 +1,128 @@
+#include "tasks.h"
+#include "system.h"
+#include "gui.h"
+#include "display.h"
+#include "ledoutput.h"
+
+#define TALLY_TASK_CORE 1
+#define TALLY_TASK_PRIORITY 5
+#define TALLY_TASK_STACK_SIZE 4096
+
+#define GUI_TASK_CORE 0
+#define GUI_TASK_PRIORITY 1
+#define GUI_TASK_STACK_SIZE 8192
+
+#define DISPLAY_TASK_CORE 1
+#define DISPLAY_TASK_PRIORITY 1
+#define DISPLAY_TASK_STACK_SIZE 3072
+
+#define LED_TASK_CORE 1
+#define LED_TASK_PRIORITY 4
+#define LED_TASK_STACK_SIZE 2048
+
+#define LOAD_WINDOW 1000000     // us over which the load is measured
+
+typedef struct {
+    TaskHandle_t handle;
+    uint32_t windowStartTime;
+    uint32_t windowBusyTime;
+    uint8_t load;
+    uint32_t maxUpdateTime;
+} TaskState;
+
+TaskState taskStates[TASK_COUNT] = {};
+
+void accountBusyTime(TaskState& state, uint32_t start, uint32_t end) {
+    uint32_t busy = end - start;
+    state.windowBusyTime += busy;
+    if (busy > state.maxUpdateTime) {
+        state.maxUpdateTime = busy;
+    }
+
+    uint32_t elapsed = end - state.windowStartTime;
+    if (elapsed >= LOAD_WINDOW) {
+        state.load = (uint64_t)state.windowBusyTime * 100 / elapsed;
+        state.windowBusyTime = 0;
+        state.windowStartTime = end;
+    }
+}
+
+void tallyTask(void *param) {
+    TaskState& state = taskStates[TASK_TALLY];
+    for (;;) {
+        uint32_t start = micros();
+        System::update(millis());
+        uint32_t end = micros();
+        System::recordLoopTime(end - start);
+        accountBusyTime(state, start, end);
+
+        // Sleep until a radio frame arrives or the next tick for serial,
+        // heartbeat and LED timing
+        ulTaskNotifyTake(pdTRUE, 1);
+    }
+}
+
+void guiTask(void *param) {
+    TaskState& state = taskStates[TASK_GUI];
+    for (;;) {
+        uint32_t start = micros();
+        GUI::update(millis());
+        accountBusyTime(state, start, micros());
+
+        vTaskDelay(1);
+    }
+}
+
+void displayTask(void *param) {
+    TaskState& state = taskStates[TASK_DISPLAY];
+    for (;;) {
+        uint8_t index = Display::waitFrame();
+        uint32_t start = micros();
+        Display::push(index);
+        accountBusyTime(state, start, micros());
+    }
+}
+
+void ledTask(void *param) {
+    TaskState& state = taskStates[TASK_LED];
+    LedFrame frame;
+    for (;;) {
+        LedOutput::waitFrame(frame);
+        uint32_t start = micros();
+        LedOutput::show(frame);
+        accountBusyTime(state, start, micros());
+    }
+}
+
+void Tasks::begin() {
+    uint32_t now = micros();
+    taskStates[TASK_TALLY].windowStartTime = now;
+    taskStates[TASK_GUI].windowStartTime = now;
+    taskStates[TASK_DISPLAY].windowStartTime = now;
+    taskStates[TASK_LED].windowStartTime = now;
+
+    xTaskCreatePinnedToCore(tallyTask, TaskNames[TASK_TALLY], TALLY_TASK_STACK_SIZE, NULL,
+        TALLY_TASK_PRIORITY, &taskStates[TASK_TALLY].handle, TALLY_TASK_CORE);
+    xTaskCreatePinnedToCore(guiTask, TaskNames[TASK_GUI], GUI_TASK_STACK_SIZE, NULL,
+        GUI_TASK_PRIORITY, &taskStates[TASK_GUI].handle, GUI_TASK_CORE);
+    xTaskCreatePinnedToCore(displayTask, TaskNames[TASK_DISPLAY], DISPLAY_TASK_STACK_SIZE, NULL,
+        DISPLAY_TASK_PRIORITY, &taskStates[TASK_DISPLAY].handle, DISPLAY_TASK_CORE);
+    xTaskCreatePinnedToCore(ledTask, TaskNames[TASK_LED], LED_TASK_STACK_SIZE, NULL,
+        LED_TASK_PRIORITY, &taskStates[TASK_LED].handle, LED_TASK_CORE);
+}
+
+void Tasks::notifyTally() {
+    TaskHandle_t handle = taskStates[TASK_TALLY].handle;
+    if (handle != NULL) {
+        xTaskNotifyGive(handle);
+    }
+}
+
+void Tasks::getStats(uint8_t task, TaskStats& stats) {
+    const TaskState& state = taskStates[task];
+    stats.name = TaskNames[task];
+    // On the ESP32 the high water mark is already in bytes
+    stats.stackHighWater = state.handle != NULL ? uxTaskGetStackHighWaterMark(state.handle) : 0;
+    stats.load = state.load;
+    stats.maxUpdateTime = state.maxUpdateTime;
+}
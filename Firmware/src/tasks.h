@@ -0,0 +1,37 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+#define TASK_TALLY 0
+#define TASK_GUI 1
+#define TASK_DISPLAY 2
+#define TASK_LED 3
+#define TASK_COUNT 4
+
+// constexpr so the menu tables can use them
+constexpr const char *TaskNames[TASK_COUNT] = { "Tally", "GUI", "Display", "LED" };
+
+typedef struct {
+    const char *name;
+    uint32_t stackHighWater;    // bytes of stack never used so far
+    uint8_t load;               // % of the last second spent in update()
+    uint32_t maxUpdateTime;     // us
+} TaskStats;
+
+// Runs System (radio, LEDs, beeper) and GUI in separate tasks. The tally
+// task is pinned to core 1 at high priority and is woken as soon as a radio
+// frame arrives, the GUI task runs at low priority on core 0 so rendering
+// never delays the LEDs. The display task pushes the frames composed by the
+// GUI task to the LCD, at low priority on core 1 so the SPI transfer
+// overlaps with rendering without delaying the tally task. The LED task
+// sends changed LED frames to the strip, so the tally task never waits on
+// the RMT transmit. Tally and GUI only talk through System::postCommand()
+// and System::getSnapshot().
+class Tasks {
+public:
+    static void begin();
+
+    // Wakes the tally task, safe to call from any task
+    static void notifyTally();
+
+    static void getStats(uint8_t task, TaskStats& stats);
+};
@@ -0,0 +1,117 @@
+#pragma once
+#include <M5StickCPlus.h>
+
+#define TX_BURST_COUNT 3            // frames sent back-to-back after a state change
+#define TX_BURST_INTERVAL 5         // ms between frames of a burst
+#define TX_HEARTBEAT_INTERVAL 250   // ms between keep-alive frames when nothing changes
+#define TX_HEARTBEAT_INTERVAL_MAX 300   // ms, three heartbeats can be lost before receivers report link loss
+
+typedef struct {
+    uint32_t framesSent;
+    uint16_t framesPerSecond;   // measured over the last full second
+    uint32_t lastTimeToAir;     // us from state change to first frame on air
+    uint32_t maxTimeToAir;
+} TxStats;
+
+// Decides when the transmitter puts a frame on air: a short burst as soon as
+// the tally state changes, then a slow heartbeat until the next change.
+// All times are in microseconds (micros()).
+class TxScheduler {
+public:
+    TxScheduler()
+        : burstCount(TX_BURST_COUNT),
+        heartbeatInterval(TX_HEARTBEAT_INTERVAL),
+        burstRemaining(0),
+        isTriggered(false),
+        triggerTime(0),
+        lastSentTime(0),
+        windowStartTime(0),
+        windowFrames(0),
+        stats({0, 0, 0, 0}) {
+    }
+
+    void setBurstCount(uint8_t val) {
+        burstCount = val > 0 ? val : 1;
+    }
+
+    uint8_t getBurstCount() const {
+        return burstCount;
+    }
+
+    void setHeartbeatInterval(uint16_t ms) {
+        if (ms < TX_BURST_INTERVAL) {
+            ms = TX_BURST_INTERVAL;
+        } else if (ms > TX_HEARTBEAT_INTERVAL_MAX) {
+            ms = TX_HEARTBEAT_INTERVAL_MAX;
+        }
+        heartbeatInterval = ms;
+    }
+
+    uint16_t getHeartbeatInterval() const {
+        return heartbeatInterval;
+    }
+
+    // Tally state changed, start a new burst. A change arriving in the middle
+    // of a burst restarts it so the last state is always repeated in full.
+    void trigger(uint32_t us) {
+        if (!isTriggered) {
+            triggerTime = us;
+            isTriggered = true;
+        }
+        burstRemaining = burstCount;
+    }
+
+    bool isDue(uint32_t us) const {
+        if (isTriggered) {
+            return true;
+        }
+        if (burstRemaining > 0) {
+            return us - lastSentTime >= TX_BURST_INTERVAL * 1000UL;
+        }
+        return us - lastSentTime >= heartbeatInterval * 1000UL;
+    }
+
+    // True when the next frame only repeats the previous one within a burst
+    bool isRepeat() const {
+        return !isTriggered && burstRemaining > 0;
+    }
+
+    void onSent(uint32_t us) {
+        if (isTriggered) {
+            stats.lastTimeToAir = us - triggerTime;
+            if (stats.lastTimeToAir > stats.maxTimeToAir) {
+                stats.maxTimeToAir = stats.lastTimeToAir;
+            }
+            isTriggered = false;
+        }
+        if (burstRemaining > 0) {
+            burstRemaining--;
+        }
+
+        lastSentTime = us;
+        stats.framesSent++;
+        windowFrames++;
+
+        uint32_t elapsed = us - windowStartTime;
+        if (elapsed >= 1000000UL) {
+            stats.framesPerSecond = (uint64_t)windowFrames * 1000000UL / elapsed;
+            windowFrames = 0;
+            windowStartTime = us;
+        }
+    }
+
+    const TxStats& getStats() const {
+        return stats;
+    }
+
+private:
+    uint8_t burstCount;
+    uint16_t heartbeatInterval;
+    uint8_t burstRemaining;
+    bool isTriggered;
+    uint32_t triggerTime;
+    uint32_t lastSentTime;
+    uint32_t windowStartTime;
+    uint16_t windowFrames;
+    TxStats stats;
+};
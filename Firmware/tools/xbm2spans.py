@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Converts the XBM bitmaps in src/xbmimages.h into the run-span format
+drawn by drawSpanImage() (src/spanimage.h) and writes src/spanimages.h.
+
+Format, one record per row from the top:
+  n (< 0x80)       n spans follow, each [x][length], set pixels only
+  0x80 | n         the previous row repeats n more times (n >= 1)
+
+Usage: tools/xbm2spans.py [src/xbmimages.h] [src/spanimages.h]
+"""
+import os
+import re
+import sys
+
+WIDTH = 135
+HEIGHT = 240
+MAX_REPEAT = 0x7F
+
+
+def parse_arrays(text):
+    """Returns {name: [bytes, ...]} where 2D arrays become name[i] entries."""
+    arrays = {}
+    for match in re.finditer(r'const unsigned char (\w+)\[\](?:\[\d+\])?\s*=\s*\{(.*?)\n\};', text, re.S):
+        name, body = match.group(1), match.group(2)
+        blocks = re.findall(r'\{([^{}]*)\}', body)
+        if blocks:
+            for i, block in enumerate(blocks):
+                arrays['%s[%d]' % (name, i)] = [int(v, 16) for v in re.findall(r'0x[0-9a-fA-F]+', block)]
+        else:
+            arrays[name] = [int(v, 16) for v in re.findall(r'0x[0-9a-fA-F]+', body)]
+    return arrays
+
+
+def row_spans(data, y):
+    row_bytes = (WIDTH + 7) // 8
+    spans = []
+    start = None
+    for x in range(WIDTH + 1):
+        bit = x < WIDTH and (data[y * row_bytes + x // 8] >> (x % 8)) & 1
+        if bit and start is None:
+            start = x
+        elif not bit and start is not None:
+            spans.append((start, x - start))
+            start = None
+    return spans
+
+
+def encode(data):
+    out = []
+    prev = None
+    repeat = 0
+    for y in range(HEIGHT):
+        spans = row_spans(data, y)
+        if spans == prev and repeat < MAX_REPEAT:
+            repeat += 1
+            continue
+        if repeat:
+            out.append(0x80 | repeat)
+            repeat = 0
+        if len(spans) >= 0x80:
+            raise ValueError('too many spans in row %d' % y)
+        out.append(len(spans))
+        for x, length in spans:
+            out += [x, length]
+        prev = spans
+    if repeat:
+        out.append(0x80 | repeat)
+    return out
+
+
+def format_array(name, values):
+    lines = ['const uint8_t %s[] = {' % name]
+    for i in range(0, len(values), 16):
+        lines.append('    ' + ', '.join('0x%02x' % v for v in values[i:i + 16]) + ',')
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def main():
+    root = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+    src = sys.argv[1] if len(sys.argv) > 1 else os.path.join(root, 'src', 'xbmimages.h')
+    dst = sys.argv[2] if len(sys.argv) > 2 else os.path.join(root, 'src', 'spanimages.h')
+
+    with open(src) as f:
+        arrays = parse_arrays(f.read())
+
+    numbers = sorted((k for k in arrays if k.startswith('NumberXBitmaps[')),
+                     key=lambda k: int(k[k.index('[') + 1:-1]))
+    parts = [
+        '// Generated by tools/xbm2spans.py from xbmimages.h, do not edit',
+        '#pragma once',
+        '#include <stdint.h>',
+        '',
+        '#define SpanImageWidth %d' % WIDTH,
+        '#define SpanImageHeight %d' % HEIGHT,
+        '',
+    ]
+    total = 0
+    for i, key in enumerate(numbers):
+        encoded = encode(arrays[key])
+        total += len(encoded)
+        parts += [format_array('NumberSpanImage%d' % i, encoded), '']
+    parts.append('const uint8_t *const NumberSpanImages[] = {')
+    parts.append('    ' + ', '.join('NumberSpanImage%d' % i for i in range(len(numbers))))
+    parts += ['};', '#define NumberSpanImageCount %d' % len(numbers), '']
+
+    encoded = encode(arrays['LogoXBitmap'])
+    total += len(encoded)
+    parts += [format_array('LogoSpanImage', encoded), '']
+
+    with open(dst, 'w') as f:
+        f.write('\n'.join(parts))
+
+    original = sum(len(v) for v in arrays.values())
+    print('%d images, %d bytes -> %d bytes' % (len(numbers) + 1, original, total))
+
+
+if __name__ == '__main__':
+    main()
@@ -17,4 +17,48 @@ extension Data {
         let format = options.contains(.upperCase) ? "%02hhX" : "%02hhx"
         return self.map { String(format: format, $0) }.joined()
     }
+
+    // Consistent Overhead Byte Stuffing, the result contains no 0x00 so
+    // a single 0x00 can delimit frames on the wire
+    func cobsEncoded() -> Data {
+        var result = Data(capacity: count + count / 254 + 1)
+        var codeIndex = result.count
+        var code: UInt8 = 1
+        result.append(0)
+
+        for byte in self {
+            if byte != 0 {
+                result.append(byte)
+                code += 1
+            }
+            if byte == 0 || code == 0xFF {
+                result[codeIndex] = code
+                codeIndex = result.count
+                code = 1
+                result.append(0)
+            }
+        }
+        result[codeIndex] = code
+        return result
+    }
+
+    func cobsDecoded() -> Data? {
+        var result = Data(capacity: count)
+        var index = startIndex
+
+        while index < endIndex {
+            let code = Int(self[index])
+            if code == 0 || index + code > endIndex {
+                return nil
+            }
+            result.append(contentsOf: self[(index + 1)..<(index + code)])
+            index += code
+            if code != 0xFF && index < endIndex {
+                result.append(0)
+            }
+        }
+
+        guard result.count > 0 else { return nil }
+        return result
+    }
 }
@@ -14,6 +14,17 @@ class Transmitter : NSObject, ORSSerialPortDelegate {
     private let switcher: Switcher
     private var port: ORSSerialPort?
     private var dataReceived: [UInt8] = []
+    private var isBinary = false
+    // Set until the first COBS frame arrives after switching to binary
+    private var isHexReplyPending = false
+    
+    // Pipelined commands, only used once the transmitter speaks binary
+    private static let windowSize = 8
+    private static let retransmitTimeout = 0.2
+    private var nextRequestId: UInt16 = 0
+    private var inFlight: [(id: UInt16, packet: [UInt8], sentAt: Date)] = []
+    private var queued: [[UInt8]] = []
+    private var retransmitTimer: Timer?
     private var pingTimer: Timer?
     private var cancellables: Set<AnyCancellable> = []
     
@@ -69,20 +80,24 @@ class Transmitter : NSObject, ORSSerialPortDelegate {
     }
     
     func sendTestCommand() {
-        send([MessageType.test, 0xFF])
+        sendCommand([MessageType.test, 0xFF])
     }
     
     func serialPortWasRemovedFromSystem(_ serialPort: ORSSerialPort) {
         port = nil
         isConnected = false
+        resetPipeline()
     }
     
     func serialPortWasClosed(_ serialPort: ORSSerialPort) {
         port = nil
         isConnected = false
+        resetPipeline()
     }
     
     func serialPortWasOpened(_ serialPort: ORSSerialPort) {
+        // Always start in hex, binary framing is requested once the transmitter answers
+        resetPipeline()
         send([MessageType.ping])
         pingTimer = Timer.scheduledTimer(withTimeInterval: 0.5, repeats: false) { _ in
             self.pingTimer = nil
@@ -96,6 +111,7 @@ class Transmitter : NSObject, ORSSerialPortDelegate {
     func serialPort(_ serialPort: ORSSerialPort, didEncounterError error: Error) {
         port = nil
         isConnected = false
+        resetPipeline()
         print("Transmitter error encounted: \(error)")
     }
     
@@ -103,7 +119,16 @@ class Transmitter : NSObject, ORSSerialPortDelegate {
         dataReceived.append(contentsOf: data)
         var i = 0
         while i < dataReceived.count {
-            if dataReceived[i] == 0x0A { // '\n'
+            if isBinary && dataReceived[i] == 0x00 {
+                isHexReplyPending = false
+                if let packet = Data(dataReceived[0..<i]).cobsDecoded() {
+                    processPacket([UInt8](packet))
+                }
+                dataReceived.removeSubrange(0...i)
+                i = 0
+                continue
+            } else if (!isBinary || isHexReplyPending && dataReceived[0..<i].allSatisfy(Transmitter.isHexCharacter))
+                        && dataReceived[i] == 0x0A { // '\n'
                 if let packet = String(data: Data(dataReceived[0..<i]), encoding: .ascii)?.hexadecimal {
                     processPacket([UInt8](packet))
                 }
@@ -136,10 +161,32 @@ class Transmitter : NSObject, ORSSerialPortDelegate {
                 pingTimer?.invalidate()
                 pingTimer = nil
                 isConnected = true
+                send([MessageType.binaryMode])
                 sendStatus()
             }
             break;
             
+        case MessageType.binaryMode:
+            // Transmitter understands COBS framing, the leading 0x00 ends any partial frame
+            if !isBinary, let port = port {
+                isBinary = true
+                // Replies to the hex frames sent before the switch still come as hex lines
+                isHexReplyPending = true
+                port.send(Data([0x00]))
+                retransmitTimer = Timer.scheduledTimer(withTimeInterval: Transmitter.retransmitTimeout / 2, repeats: true) { _ in
+                    self.retransmit()
+                }
+            }
+            break
+            
+        case MessageType.ack:
+            if data.count == 10 {
+                let cumulative = UInt16(data[2]) | (UInt16(data[3]) << 8)
+                let selective = UInt32(data[4]) | (UInt32(data[5]) << 8) | (UInt32(data[6]) << 16) | (UInt32(data[7]) << 24)
+                processAck(cumulative, selective)
+            }
+            break
+            
         case MessageType.error:
             print("Error message received from transmitter")
             break
@@ -150,7 +197,7 @@ class Transmitter : NSObject, ORSSerialPortDelegate {
     }
     
     private func sendStatus(_ previewId: UInt64? = nil, _ programId: UInt64? = nil) {
-        let count = switcher.inputs.numberOfExternalInput
+        let count = min(switcher.inputs.numberOfExternalInput, CameraStatus.maxCount)
         if count == 0 {
             return
         }
@@ -165,19 +212,80 @@ class Transmitter : NSObject, ORSSerialPortDelegate {
             programId = switcher.programId
         }
         
-        var packet: [UInt8] = [MessageType.status, UInt8(count)]
+        // 2 bits per camera, four cameras per byte, camera 1 in the lowest bits
+        var packet: [UInt8] = [MessageType.statusPacked, UInt8(count)]
+        packet.append(contentsOf: [UInt8](repeating: 0, count: (count + 3) / 4))
         for i in 1...count {
+            var status = CameraStatus.standby
             if i == programId! {
-                packet.append(CameraStatus.program)
+                status = CameraStatus.program
             } else if i == previewId! {
-                packet.append(CameraStatus.preview)
-            } else {
-                packet.append(CameraStatus.standby)
+                status = CameraStatus.preview
             }
+            packet[2 + (i - 1) / 4] |= status << UInt8(((i - 1) % 4) * 2)
+        }
+        sendCommand(packet)
+    }
+    
+    private func resetPipeline() {
+        isBinary = false
+        isHexReplyPending = false
+        inFlight.removeAll()
+        queued.removeAll()
+        retransmitTimer?.invalidate()
+        retransmitTimer = nil
+    }
+    
+    // Keeps up to windowSize commands in flight instead of waiting for each reply
+    private func sendCommand(_ data: [UInt8]) {
+        guard isBinary else {
+            send(data)
+            return
         }
+        
+        if inFlight.count >= Transmitter.windowSize {
+            // Only the latest status matters while waiting for the window to open
+            if data[0] == MessageType.statusPacked {
+                queued.removeAll { $0[0] == MessageType.statusPacked }
+            }
+            queued.append(data)
+            return
+        }
+        
+        sendSequenced(data)
+    }
+    
+    private func sendSequenced(_ data: [UInt8]) {
+        let id = nextRequestId
+        nextRequestId &+= 1
+        
+        var packet = data
+        packet[0] |= MessageType.sequenceFlag
+        packet.insert(contentsOf: [UInt8(id & 0xFF), UInt8(id >> 8)], at: 1)
+        inFlight.append((id: id, packet: packet, sentAt: Date()))
         send(packet)
     }
     
+    // Everything up to the cumulative ID is done, bit i of selective acks cumulative + 2 + i
+    private func processAck(_ cumulative: UInt16, _ selective: UInt32) {
+        inFlight.removeAll { entry in
+            let diff = Int16(bitPattern: entry.id &- cumulative)
+            return diff <= 0 || (diff >= 2 && diff <= 33 && (selective >> UInt32(diff - 2)) & 1 == 1)
+        }
+        
+        while inFlight.count < Transmitter.windowSize && !queued.isEmpty {
+            sendSequenced(queued.removeFirst())
+        }
+    }
+    
+    private func retransmit() {
+        let now = Date()
+        for i in 0..<inFlight.count where now.timeIntervalSince(inFlight[i].sentAt) >= Transmitter.retransmitTimeout {
+            inFlight[i].sentAt = now
+            send(inFlight[i].packet)
+        }
+    }
+    
     private func send(_ data: [UInt8]) {
         guard let port = port else {
             return
@@ -191,8 +299,15 @@ class Transmitter : NSObject, ORSSerialPortDelegate {
         bytes.append(UInt8(crc & 0xFF))
         bytes.append(UInt8((crc >> 8) & 0xFF))
         
-        let str = "\(Data(bytes).hexEncodedString())\n"
-        if !port.send(str.data(using: .ascii)!) {
+        var frame: Data
+        if isBinary {
+            frame = Data(bytes).cobsEncoded()
+            frame.append(0x00)
+        } else {
+            frame = "\(Data(bytes).hexEncodedString())\n".data(using: .ascii)!
+        }
+        
+        if !port.send(frame) {
             print("Failed to send data to transmitter")
         }
     }
@@ -218,6 +333,10 @@ class Transmitter : NSObject, ORSSerialPortDelegate {
         let crc = calculateCRC(for: data[0..<length-2])
         return crc == (UInt16(data[length-2]) | (UInt16(data[length-1]) << 8))
     }
+    
+    private static func isHexCharacter(_ c: UInt8) -> Bool {
+        return (c >= 0x30 && c <= 0x39) || (c >= 0x41 && c <= 0x46) || (c >= 0x61 && c <= 0x66)
+    }
 }
 
 fileprivate class MessageType {
@@ -225,6 +344,13 @@ fileprivate class MessageType {
     static let status      : UInt8 = 0x02
     static let ping        : UInt8 = 0x03
     static let pong        : UInt8 = 0x04
+    static let txConfig    : UInt8 = 0x05
+    static let statusPacked: UInt8 = 0x06
+    static let linkStats   : UInt8 = 0x07
+    static let binaryMode  : UInt8 = 0x08
+    static let ack         : UInt8 = 0x09
+    
+    static let sequenceFlag: UInt8 = 0x40
 
     static let ok          : UInt8 = 0x00
     static let error       : UInt8 = 0xFF
@@ -235,4 +361,6 @@ fileprivate class CameraStatus {
     static let standby     : UInt8 = 0
     static let preview     : UInt8 = 1
     static let program     : UInt8 = 2
+
+    static let maxCount    : Int = 64
 }